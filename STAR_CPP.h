@@ -21,6 +21,8 @@ TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
 #include "star/star_io.h"
 #include "star/star_graph.h"
 #include "star/star_random.h"
+#include "star/star_distribution.h"
+#include "star/star_permutation.h"
 #include "star/star_sequence.h"
 #include "star/star_math.h"
 #include "star/extend/StarExtendedRandomEngine.h"
@@ -0,0 +1,74 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+// Bulk generation: seconds to fill n values with a per-call randint/random loop
+// against one randint_fill/random_fill call, on the default locked Random.
+//
+//   g++ -std=c++20 -O2 -pthread StarBulkBench.cpp -o StarBulkBench
+//   ./StarBulkBench [n]
+
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<random>
+#include<span>
+#include<vector>
+#include "../star_random.h"
+
+using namespace STAR_CPP;
+using namespace STAR_CPP::extend;
+
+template <typename F>
+static double seconds(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Engine>
+static void bench(const char* name, size_t n) {
+	std::vector<int> ints(n);
+	std::vector<double> reals(n);
+	double sink = 0;
+
+	Random<Engine> rng(1);
+	double int_loop = seconds([&] {
+		for (int& x : ints) x = rng.randint(1, 1000000);
+	});
+	sink += ints[n / 2];
+	double int_bulk = seconds([&] { rng.randint_fill(std::span<int>(ints), 1, 1000000); });
+	sink += ints[n / 2];
+	double real_loop = seconds([&] {
+		for (double& x : reals) x = rng.random();
+	});
+	sink += reals[n / 2];
+	double real_bulk = seconds([&] { rng.random_fill(std::span<double>(reals)); });
+	sink += reals[n / 2];
+
+	std::printf("%-16s randint %.3fs -> %.3fs   random %.3fs -> %.3fs  (%d)\n",
+		name, int_loop, int_bulk, real_loop, real_bulk, static_cast<int>(sink) % 10);
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	if (n == 0) return 0;
+	bench<std::mt19937>("std::mt19937", n);
+	bench<SplitMix64Rand>("SplitMix64Rand", n);
+	bench<XSH_RR_PCG>("XSH_RR_PCG", n);
+	bench<WyRand>("WyRand", n);
+	return 0;
+}
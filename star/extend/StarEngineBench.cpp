@@ -0,0 +1,72 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+// Engine throughput: ns/draw and GB/s of raw output, and ns per
+// UnsyncRandom<Engine>::randint(1, 10^6) call.
+//
+//   g++ -std=c++20 -O2 -pthread StarEngineBench.cpp -o StarEngineBench
+//   ./StarEngineBench [draws]
+
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<random>
+#include "../star_random.h"
+
+using namespace STAR_CPP;
+using namespace STAR_CPP::extend;
+
+template <typename F>
+static double seconds(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Engine>
+static void bench(const char* name, size_t draws) {
+	unsigned long long sink = 0;
+	Engine engine(1);
+	double raw = seconds([&] {
+		for (size_t i = 0; i < draws; ++i) sink += engine();
+	});
+	UnsyncRandom<Engine> rng(1);
+	double wrapped = seconds([&] {
+		for (size_t i = 0; i < draws; ++i) sink += rng.randint(1, 1000000);
+	});
+	double bytes = static_cast<double>(draws) * sizeof(typename Engine::result_type);
+	std::printf("%-20s %6.2f ns %6.2f GB/s | randint %6.2f ns  (%llu)\n",
+		name, raw / draws * 1e9, bytes / raw / 1e9, wrapped / draws * 1e9, sink % 10);
+}
+
+int main(int argc, char** argv) {
+	size_t draws = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+	bench<std::mt19937>("std::mt19937", draws);
+	bench<std::mt19937_64>("std::mt19937_64", draws);
+	bench<MinstdLCG>("MinstdLCG", draws);
+	bench<SplitMix64Rand>("SplitMix64Rand", draws);
+	bench<XSH_RR_PCG>("XSH_RR_PCG", draws);
+	bench<Xoshiro256StarStar>("Xoshiro256StarStar", draws);
+	bench<Xoshiro128Plus>("Xoshiro128Plus", draws);
+	bench<WyRand>("WyRand", draws);
+	bench<SFC64>("SFC64", draws);
+	bench<Philox4x32>("Philox4x32", draws);
+	bench<SplitMix64x4>("SplitMix64x4", draws);
+	bench<Xoshiro256x4>("Xoshiro256x4", draws);
+	bench<XSH_RR_PCGx8>("XSH_RR_PCGx8", draws);
+	return 0;
+}
@@ -19,8 +19,46 @@ TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
 #define STAR_RAND_GENE_H
 
 #include "..\utils\StarError.h"
+#include<cstdint>
+#include<cstddef>
+#include<cstring>
+#include<algorithm>
+
+#if !defined(STAR_NO_SIMD) && defined(__AVX2__)
+#include<immintrin.h>
+#define STAR_SIMD_AVX2 1
+#elif !defined(STAR_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include<emmintrin.h>
+#define STAR_SIMD_SSE2 1
+#endif
+
 namespace STAR_CPP {
 	namespace extend {
+#if defined(__SIZEOF_INT128__)
+		__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+		inline uint64_t mix64(uint64_t z) {
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			return z ^ (z >> 31);
+		}
+
+		inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t* high) {
+#if defined(__SIZEOF_INT128__)
+			uint128_t product = static_cast<uint128_t>(a) * b;
+			*high = static_cast<uint64_t>(product >> 64);
+			return static_cast<uint64_t>(product);
+#else
+			uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+			uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+			uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+			uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+			*high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+			return (cross << 32) | (lo_lo & 0xffffffffULL);
+#endif
+		}
+
 		class MinstdLCG {
 		public:
 			using result_type = uint32_t;
@@ -32,7 +70,9 @@ namespace STAR_CPP {
 
 			result_type operator ()() {
 				const uint64_t product = static_cast<uint64_t>(state) * A;
-				state = static_cast<result_type>(product % M);
+				uint64_t folded = (product & M) + (product >> 31);
+				if (folded >= M) folded -= M;
+				state = static_cast<result_type>(folded);
 				return state;
 			}
 
@@ -52,6 +92,15 @@ namespace STAR_CPP {
 				return A;
 			}
 
+			void discard(uint64_t n) {
+				uint64_t mult = 1, base = A;
+				for (n %= M - 1; n > 0; n >>= 1) {
+					if (n & 1) mult = mult * base % M;
+					base = base * base % M;
+				}
+				state = static_cast<result_type>(static_cast<uint64_t>(state) * mult % M);
+			}
+
 		private:
 			result_type state;
 			static constexpr result_type M = 2147483647;
@@ -80,6 +129,21 @@ namespace STAR_CPP {
 				return z ^ (z >> 31);
 			}
 
+			void discard(uint64_t n) {
+				state += n * 0x9e3779b97f4a7c15;
+			}
+
+			// Substream k starts at a position hashed from (state, k), so children of
+			// different parents or indices land at unrelated points of the 2^64 cycle
+			// instead of at fixed offsets that a later split() could reach.
+			SplitMix64Rand stream(uint64_t k) const {
+				return SplitMix64Rand(mix64(state ^ mix64((k + 1) * 0x9e3779b97f4a7c15ULL)));
+			}
+
+			SplitMix64Rand split() {
+				return stream((*this)());
+			}
+
 		private:
 			uint64_t state;
 		};
@@ -114,10 +178,617 @@ namespace STAR_CPP {
 				return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
 			}
 
+			void discard(uint64_t n) {
+				uint64_t cur_mult = 6364136223846793005ULL, cur_plus = increment;
+				uint64_t acc_mult = 1, acc_plus = 0;
+				for (; n > 0; n >>= 1) {
+					if (n & 1) {
+						acc_mult *= cur_mult;
+						acc_plus = acc_plus * cur_mult + cur_plus;
+					}
+					cur_plus = (cur_mult + 1) * cur_plus;
+					cur_mult *= cur_mult;
+				}
+				state = acc_mult * state + acc_plus;
+			}
+
+			// Substream k walks a different LCG sequence, selected by an increment
+			// derived from k, and is re-seeded with the state mixed into that increment.
+			XSH_RR_PCG stream(uint64_t k) const {
+				XSH_RR_PCG child(*this);
+				child.increment = (mix64(increment + (k + 1) * 0x9e3779b97f4a7c15ULL) << 1) | 1;
+				child.state = mix64(state ^ child.increment);
+				return child;
+			}
+
+			XSH_RR_PCG split() {
+				uint64_t k = static_cast<uint64_t>((*this)()) << 32;
+				k |= (*this)();
+				return stream(k);
+			}
+
 		private:
 			uint64_t state;
 			uint64_t increment;
 		};
+
+		namespace simd {
+			inline uint64_t rotl64(uint64_t x, int k) {
+				return (x << k) | (x >> (64 - k));
+			}
+
+			inline uint32_t rotr32(uint32_t x, uint32_t r) {
+				return (x >> r) | (x << ((-r) & 31));
+			}
+
+#if defined(STAR_SIMD_AVX2)
+			inline __m256i mullo64(__m256i a, __m256i b) {
+				__m256i lo = _mm256_mul_epu32(a, b);
+				__m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+				return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+			}
+
+			template <int K>
+			inline __m256i rotl64(__m256i x) {
+				return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K));
+			}
+#endif
+
+#if defined(STAR_SIMD_AVX2) || defined(STAR_SIMD_SSE2)
+			template <int K>
+			inline __m128i rotl64(__m128i x) {
+				return _mm_or_si128(_mm_slli_epi64(x, K), _mm_srli_epi64(x, 64 - K));
+			}
+#endif
+		}
+
+		class Xoshiro256StarStar {
+		public:
+			using result_type = uint64_t;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 18446744073709551615ULL;
+			}
+
+			explicit Xoshiro256StarStar(uint64_t seed) {
+				SplitMix64Rand sm(seed);
+				for (int i = 0; i < 4; ++i) s[i] = sm();
+			}
+
+			result_type operator()() {
+				const uint64_t result = rotl(s[1] * 5, 7) * 9;
+				const uint64_t t = s[1] << 17;
+				s[2] ^= s[0];
+				s[3] ^= s[1];
+				s[1] ^= s[2];
+				s[0] ^= s[3];
+				s[2] ^= t;
+				s[3] = rotl(s[3], 45);
+				return result;
+			}
+
+		private:
+			uint64_t s[4];
+
+			static uint64_t rotl(uint64_t x, int k) {
+				return (x << k) | (x >> (64 - k));
+			}
+		};
+
+		class Xoshiro128Plus {
+		public:
+			using result_type = uint32_t;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 4294967295U;
+			}
+
+			explicit Xoshiro128Plus(uint64_t seed) {
+				SplitMix64Rand sm(seed);
+				uint64_t a = sm(), b = sm();
+				s[0] = static_cast<uint32_t>(a); s[1] = static_cast<uint32_t>(a >> 32);
+				s[2] = static_cast<uint32_t>(b); s[3] = static_cast<uint32_t>(b >> 32);
+			}
+
+			result_type operator()() {
+				const uint32_t result = s[0] + s[3];
+				const uint32_t t = s[1] << 9;
+				s[2] ^= s[0];
+				s[3] ^= s[1];
+				s[1] ^= s[2];
+				s[0] ^= s[3];
+				s[2] ^= t;
+				s[3] = (s[3] << 11) | (s[3] >> 21);
+				return result;
+			}
+
+		private:
+			uint32_t s[4];
+		};
+
+		class WyRand {
+		public:
+			using result_type = uint64_t;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 18446744073709551615ULL;
+			}
+
+			explicit WyRand(uint64_t seed) : state(seed) {}
+
+			result_type operator()() {
+				state += 0xa0761d6478bd642fULL;
+				uint64_t high;
+				uint64_t low = mul128(state, state ^ 0xe7037ed1a0b428dbULL, &high);
+				return high ^ low;
+			}
+
+		private:
+			uint64_t state;
+		};
+
+		class SFC64 {
+		public:
+			using result_type = uint64_t;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 18446744073709551615ULL;
+			}
+
+			explicit SFC64(uint64_t seed) : a(seed), b(seed), c(seed), counter(1) {
+				for (int i = 0; i < 12; ++i) (*this)();
+			}
+
+			result_type operator()() {
+				const uint64_t result = a + b + counter++;
+				a = b ^ (b >> 11);
+				b = c + (c << 3);
+				c = ((c << 24) | (c >> 40)) + result;
+				return result;
+			}
+
+		private:
+			uint64_t a, b, c, counter;
+		};
+
+		// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+		// Value i of a stream is a pure function of (key, stream, i), so any slice
+		// of the sequence can be computed independently with at() or discard().
+		class Philox4x32 {
+		public:
+			using result_type = uint32_t;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 4294967295U;
+			}
+
+			explicit Philox4x32(uint64_t seed, uint64_t stream_id = 0)
+				: key{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) }, stream_id(stream_id), position(0), cached_block(~uint64_t(0)) {}
+
+			result_type operator()() {
+				uint64_t block = position >> 2;
+				if (block != cached_block) {
+					generate_block(block, cache);
+					cached_block = block;
+				}
+				return cache[position++ & 3];
+			}
+
+			result_type at(uint64_t index) const {
+				uint32_t out[4];
+				generate_block(index >> 2, out);
+				return out[index & 3];
+			}
+
+			void fill(result_type* out, size_t n) {
+				while (n > 0 && (position & 3) != 0) {
+					*out++ = (*this)();
+					--n;
+				}
+				for (; n >= 4 * BATCH; n -= 4 * BATCH, out += 4 * BATCH, position += 4 * BATCH) generate_batch(position >> 2, out);
+				for (; n >= 4; n -= 4, out += 4, position += 4) generate_block(position >> 2, out);
+				while (n > 0) {
+					*out++ = (*this)();
+					--n;
+				}
+			}
+
+			void discard(uint64_t n) {
+				position += n;
+			}
+
+			uint64_t tell() const {
+				return position;
+			}
+
+			Philox4x32 stream(uint64_t k) const {
+				return Philox4x32((uint64_t(key[1]) << 32) | key[0], mix64(stream_id + (k + 1) * 0x9e3779b97f4a7c15ULL));
+			}
+
+			Philox4x32 split() {
+				uint64_t k = static_cast<uint64_t>((*this)()) << 32;
+				k |= (*this)();
+				return stream(k);
+			}
+
+		private:
+			static constexpr uint32_t M0 = 0xD2511F53;
+			static constexpr uint32_t M1 = 0xCD9E8D57;
+			static constexpr uint32_t W0 = 0x9E3779B9;
+			static constexpr uint32_t W1 = 0xBB67AE85;
+			static constexpr size_t BATCH = 8;
+
+			uint32_t key[2];
+			uint64_t stream_id;
+			uint64_t position;
+			uint64_t cached_block;
+			uint32_t cache[4];
+
+			void generate_block(uint64_t block, uint32_t* out) const {
+				uint32_t c0 = static_cast<uint32_t>(block), c1 = static_cast<uint32_t>(block >> 32);
+				uint32_t c2 = static_cast<uint32_t>(stream_id), c3 = static_cast<uint32_t>(stream_id >> 32);
+				uint32_t k0 = key[0], k1 = key[1];
+				for (int round = 0; round < 10; ++round) {
+					uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+					uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+					uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+					uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+					c1 = static_cast<uint32_t>(p1);
+					c3 = static_cast<uint32_t>(p0);
+					c0 = n0;
+					c2 = n2;
+					k0 += W0;
+					k1 += W1;
+				}
+				out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+			}
+
+			// Same rounds as generate_block over BATCH consecutive counters, laid out so
+			// the compiler can keep one counter per vector lane.
+			void generate_batch(uint64_t first_block, uint32_t* out) const {
+				uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+				for (size_t j = 0; j < BATCH; ++j) {
+					c0[j] = static_cast<uint32_t>(first_block + j);
+					c1[j] = static_cast<uint32_t>((first_block + j) >> 32);
+					c2[j] = static_cast<uint32_t>(stream_id);
+					c3[j] = static_cast<uint32_t>(stream_id >> 32);
+				}
+				uint32_t k0 = key[0], k1 = key[1];
+				for (int round = 0; round < 10; ++round) {
+					for (size_t j = 0; j < BATCH; ++j) {
+						uint64_t p0 = static_cast<uint64_t>(M0) * c0[j];
+						uint64_t p1 = static_cast<uint64_t>(M1) * c2[j];
+						c0[j] = static_cast<uint32_t>(p1 >> 32) ^ c1[j] ^ k0;
+						c2[j] = static_cast<uint32_t>(p0 >> 32) ^ c3[j] ^ k1;
+						c1[j] = static_cast<uint32_t>(p1);
+						c3[j] = static_cast<uint32_t>(p0);
+					}
+					k0 += W0;
+					k1 += W1;
+				}
+				for (size_t j = 0; j < BATCH; ++j) {
+					out[4 * j] = c0[j]; out[4 * j + 1] = c1[j]; out[4 * j + 2] = c2[j]; out[4 * j + 3] = c3[j];
+				}
+			}
+		};
+
+		// Multi-lane engines: several independent states are advanced together and
+		// their outputs are interleaved lane by lane into an internal buffer.
+		// The AVX2, SSE2 and scalar kernels produce identical sequences. SSE2 has no
+		// 64-bit lane multiply, so only the multiply-free xoshiro kernel uses it.
+		class SplitMix64x4 {
+		public:
+			using result_type = uint64_t;
+			static constexpr size_t lanes = 4;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 18446744073709551615ULL;
+			}
+
+			// Lane l starts 2^62 * l steps ahead of lane 0, so lanes never overlap.
+			explicit SplitMix64x4(uint64_t seed) : pos(BUFFER_SIZE) {
+				for (size_t l = 0; l < lanes; ++l) state[l] = seed + GAMMA * (uint64_t(l) << 62);
+			}
+
+			result_type operator()() {
+				if (pos == BUFFER_SIZE) {
+					generate(buffer);
+					pos = 0;
+				}
+				return buffer[pos++];
+			}
+
+			void fill(result_type* out, size_t n) {
+				while (n > 0) {
+					if (pos == BUFFER_SIZE) {
+						if (n >= BUFFER_SIZE) {
+							generate(out);
+							out += BUFFER_SIZE; n -= BUFFER_SIZE;
+							continue;
+						}
+						generate(buffer);
+						pos = 0;
+					}
+					size_t take = std::min(n, BUFFER_SIZE - pos);
+					std::memcpy(out, buffer + pos, take * sizeof(result_type));
+					pos += take; out += take; n -= take;
+				}
+			}
+
+		private:
+			static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15ULL;
+			static constexpr uint64_t MIX1 = 0xbf58476d1ce4e5b9ULL;
+			static constexpr uint64_t MIX2 = 0x94d049bb133111ebULL;
+			static constexpr size_t ROUNDS = 16;
+			static constexpr size_t BUFFER_SIZE = lanes * ROUNDS;
+
+			alignas(32) uint64_t state[lanes];
+			alignas(32) result_type buffer[BUFFER_SIZE];
+			size_t pos;
+
+			void generate(result_type* out) {
+#if defined(STAR_SIMD_AVX2)
+				__m256i s = _mm256_load_si256((const __m256i*)state);
+				const __m256i gamma = _mm256_set1_epi64x((long long)GAMMA);
+				const __m256i m1 = _mm256_set1_epi64x((long long)MIX1);
+				const __m256i m2 = _mm256_set1_epi64x((long long)MIX2);
+				for (size_t r = 0; r < ROUNDS; ++r) {
+					s = _mm256_add_epi64(s, gamma);
+					__m256i z = simd::mullo64(_mm256_xor_si256(s, _mm256_srli_epi64(s, 30)), m1);
+					z = simd::mullo64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), m2);
+					z = _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+					_mm256_storeu_si256((__m256i*)(out + r * lanes), z);
+				}
+				_mm256_store_si256((__m256i*)state, s);
+#else
+				for (size_t r = 0; r < ROUNDS; ++r) {
+					for (size_t l = 0; l < lanes; ++l) {
+						uint64_t z = (state[l] += GAMMA);
+						z = (z ^ (z >> 30)) * MIX1;
+						z = (z ^ (z >> 27)) * MIX2;
+						out[r * lanes + l] = z ^ (z >> 31);
+					}
+				}
+#endif
+			}
+		};
+
+		class Xoshiro256x4 {
+		public:
+			using result_type = uint64_t;
+			static constexpr size_t lanes = 4;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 18446744073709551615ULL;
+			}
+
+			// Every lane runs xoshiro256** with its own state drawn from SplitMix64.
+			explicit Xoshiro256x4(uint64_t seed) : pos(BUFFER_SIZE) {
+				SplitMix64Rand sm(seed);
+				for (size_t l = 0; l < lanes; ++l) {
+					for (int w = 0; w < 4; ++w) state[w][l] = sm();
+				}
+			}
+
+			result_type operator()() {
+				if (pos == BUFFER_SIZE) {
+					generate(buffer);
+					pos = 0;
+				}
+				return buffer[pos++];
+			}
+
+			void fill(result_type* out, size_t n) {
+				while (n > 0) {
+					if (pos == BUFFER_SIZE) {
+						if (n >= BUFFER_SIZE) {
+							generate(out);
+							out += BUFFER_SIZE; n -= BUFFER_SIZE;
+							continue;
+						}
+						generate(buffer);
+						pos = 0;
+					}
+					size_t take = std::min(n, BUFFER_SIZE - pos);
+					std::memcpy(out, buffer + pos, take * sizeof(result_type));
+					pos += take; out += take; n -= take;
+				}
+			}
+
+		private:
+			static constexpr size_t ROUNDS = 16;
+			static constexpr size_t BUFFER_SIZE = lanes * ROUNDS;
+
+			alignas(32) uint64_t state[4][lanes];
+			alignas(32) result_type buffer[BUFFER_SIZE];
+			size_t pos;
+
+			void generate(result_type* out) {
+#if defined(STAR_SIMD_AVX2)
+				__m256i s0 = _mm256_load_si256((const __m256i*)state[0]);
+				__m256i s1 = _mm256_load_si256((const __m256i*)state[1]);
+				__m256i s2 = _mm256_load_si256((const __m256i*)state[2]);
+				__m256i s3 = _mm256_load_si256((const __m256i*)state[3]);
+				for (size_t r = 0; r < ROUNDS; ++r) {
+					__m256i x5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+					__m256i rot = simd::rotl64<7>(x5);
+					_mm256_storeu_si256((__m256i*)(out + r * lanes), _mm256_add_epi64(_mm256_slli_epi64(rot, 3), rot));
+					__m256i t = _mm256_slli_epi64(s1, 17);
+					s2 = _mm256_xor_si256(s2, s0);
+					s3 = _mm256_xor_si256(s3, s1);
+					s1 = _mm256_xor_si256(s1, s2);
+					s0 = _mm256_xor_si256(s0, s3);
+					s2 = _mm256_xor_si256(s2, t);
+					s3 = simd::rotl64<45>(s3);
+				}
+				_mm256_store_si256((__m256i*)state[0], s0);
+				_mm256_store_si256((__m256i*)state[1], s1);
+				_mm256_store_si256((__m256i*)state[2], s2);
+				_mm256_store_si256((__m256i*)state[3], s3);
+#elif defined(STAR_SIMD_SSE2)
+				for (size_t h = 0; h < lanes; h += 2) {
+					__m128i s0 = _mm_load_si128((const __m128i*)(state[0] + h));
+					__m128i s1 = _mm_load_si128((const __m128i*)(state[1] + h));
+					__m128i s2 = _mm_load_si128((const __m128i*)(state[2] + h));
+					__m128i s3 = _mm_load_si128((const __m128i*)(state[3] + h));
+					for (size_t r = 0; r < ROUNDS; ++r) {
+						__m128i x5 = _mm_add_epi64(_mm_slli_epi64(s1, 2), s1);
+						__m128i rot = simd::rotl64<7>(x5);
+						_mm_storeu_si128((__m128i*)(out + r * lanes + h), _mm_add_epi64(_mm_slli_epi64(rot, 3), rot));
+						__m128i t = _mm_slli_epi64(s1, 17);
+						s2 = _mm_xor_si128(s2, s0);
+						s3 = _mm_xor_si128(s3, s1);
+						s1 = _mm_xor_si128(s1, s2);
+						s0 = _mm_xor_si128(s0, s3);
+						s2 = _mm_xor_si128(s2, t);
+						s3 = simd::rotl64<45>(s3);
+					}
+					_mm_store_si128((__m128i*)(state[0] + h), s0);
+					_mm_store_si128((__m128i*)(state[1] + h), s1);
+					_mm_store_si128((__m128i*)(state[2] + h), s2);
+					_mm_store_si128((__m128i*)(state[3] + h), s3);
+				}
+#else
+				for (size_t l = 0; l < lanes; ++l) {
+					uint64_t s0 = state[0][l], s1 = state[1][l], s2 = state[2][l], s3 = state[3][l];
+					for (size_t r = 0; r < ROUNDS; ++r) {
+						out[r * lanes + l] = simd::rotl64(s1 * 5, 7) * 9;
+						uint64_t t = s1 << 17;
+						s2 ^= s0;
+						s3 ^= s1;
+						s1 ^= s2;
+						s0 ^= s3;
+						s2 ^= t;
+						s3 = simd::rotl64(s3, 45);
+					}
+					state[0][l] = s0; state[1][l] = s1; state[2][l] = s2; state[3][l] = s3;
+				}
+#endif
+			}
+		};
+
+		class XSH_RR_PCGx8 {
+		public:
+			using result_type = uint32_t;
+			static constexpr size_t lanes = 8;
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return 4294967295U;
+			}
+
+			// Lane l is an XSH_RR_PCG seeded with the l-th SplitMix64 output of seed.
+			explicit XSH_RR_PCGx8(uint64_t seed) : pos(BUFFER_SIZE) {
+				SplitMix64Rand sm(seed);
+				for (size_t l = 0; l < lanes; ++l) {
+					uint64_t lane_seed = sm();
+					increment[l] = (lane_seed << 1) | 1;
+					state[l] = lane_seed * MULT + increment[l];
+				}
+			}
+
+			result_type operator()() {
+				if (pos == BUFFER_SIZE) {
+					generate(buffer);
+					pos = 0;
+				}
+				return buffer[pos++];
+			}
+
+			void fill(result_type* out, size_t n) {
+				while (n > 0) {
+					if (pos == BUFFER_SIZE) {
+						if (n >= BUFFER_SIZE) {
+							generate(out);
+							out += BUFFER_SIZE; n -= BUFFER_SIZE;
+							continue;
+						}
+						generate(buffer);
+						pos = 0;
+					}
+					size_t take = std::min(n, BUFFER_SIZE - pos);
+					std::memcpy(out, buffer + pos, take * sizeof(result_type));
+					pos += take; out += take; n -= take;
+				}
+			}
+
+		private:
+			static constexpr uint64_t MULT = 6364136223846793005ULL;
+			static constexpr size_t ROUNDS = 16;
+			static constexpr size_t BUFFER_SIZE = lanes * ROUNDS;
+
+			alignas(32) uint64_t state[lanes];
+			alignas(32) uint64_t increment[lanes];
+			alignas(32) result_type buffer[BUFFER_SIZE];
+			size_t pos;
+
+			void generate(result_type* out) {
+#if defined(STAR_SIMD_AVX2)
+				__m256i lo = _mm256_load_si256((const __m256i*)state);
+				__m256i hi = _mm256_load_si256((const __m256i*)(state + 4));
+				const __m256i inc_lo = _mm256_load_si256((const __m256i*)increment);
+				const __m256i inc_hi = _mm256_load_si256((const __m256i*)(increment + 4));
+				const __m256i mult = _mm256_set1_epi64x((long long)MULT);
+				const __m256i mask = _mm256_set1_epi32(31);
+				const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+				auto output = [&](__m256i old) {
+					__m256i xorshifted = _mm256_srli_epi64(_mm256_xor_si256(_mm256_srli_epi64(old, 18), old), 27);
+					__m256i rot = _mm256_srli_epi64(old, 59);
+					__m256i back = _mm256_and_si256(_mm256_sub_epi32(_mm256_setzero_si256(), rot), mask);
+					return _mm256_or_si256(_mm256_srlv_epi32(xorshifted, rot), _mm256_sllv_epi32(xorshifted, back));
+				};
+				for (size_t r = 0; r < ROUNDS; ++r) {
+					__m256i out_lo = output(lo);
+					__m256i out_hi = output(hi);
+					__m256i packed = _mm256_blend_epi32(out_lo, _mm256_slli_epi64(out_hi, 32), 0xAA);
+					_mm256_storeu_si256((__m256i*)(out + r * lanes), _mm256_permutevar8x32_epi32(packed, order));
+					lo = _mm256_add_epi64(simd::mullo64(lo, mult), inc_lo);
+					hi = _mm256_add_epi64(simd::mullo64(hi, mult), inc_hi);
+				}
+				_mm256_store_si256((__m256i*)state, lo);
+				_mm256_store_si256((__m256i*)(state + 4), hi);
+#else
+				for (size_t r = 0; r < ROUNDS; ++r) {
+					for (size_t l = 0; l < lanes; ++l) {
+						uint64_t old = state[l];
+						state[l] = old * MULT + increment[l];
+						out[r * lanes + l] = simd::rotr32(uint32_t(((old >> 18u) ^ old) >> 27u), uint32_t(old >> 59u));
+					}
+				}
+#endif
+			}
+		};
 	}
 }
 
@@ -0,0 +1,65 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+// Locking policy cost: Mdraws/s of Graph<Engine>::randomGraph(n, p) with the
+// default std::mutex against Graph<Engine, ..., NullMutex>. One draw per pair.
+//
+//   g++ -std=c++20 -O2 -pthread StarLockBench.cpp -o StarLockBench
+//   ./StarLockBench [n] [p]
+
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<mutex>
+#include<random>
+#include "../star_graph.h"
+
+using namespace STAR_CPP;
+using namespace STAR_CPP::extend;
+
+template <typename F>
+static double seconds(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Engine, typename Lock>
+static double mdraws(int n, double p, size_t& sink) {
+	Graph<Engine, int, long long, Lock> graph(1);
+	double elapsed = seconds([&] { sink += graph.randomGraph(n, p).size(); });
+	double draws = static_cast<double>(n) * (n - 1) / 2;
+	return draws / elapsed / 1e6;
+}
+
+template <typename Engine>
+static void bench(const char* name, int n, double p) {
+	size_t sink = 0;
+	double locked = mdraws<Engine, std::mutex>(n, p, sink);
+	double unlocked = mdraws<Engine, NullMutex>(n, p, sink);
+	std::printf("%-16s std::mutex %7.1f Mdraws/s   NullMutex %7.1f Mdraws/s  (%zu edges)\n",
+		name, locked, unlocked, sink / 2);
+}
+
+int main(int argc, char** argv) {
+	int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+	double p = argc > 2 ? std::atof(argv[2]) : 0.001;
+	bench<std::mt19937_64>("std::mt19937_64", n, p);
+	bench<SplitMix64Rand>("SplitMix64Rand", n, p);
+	bench<XSH_RR_PCG>("XSH_RR_PCG", n, p);
+	return 0;
+}
@@ -0,0 +1,124 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+// is_prime throughput on random 62-bit numbers: the original shift-and-add
+// Miller-Rabin (copied below as the "before" reference) against
+// Math<long long>::is_prime. Both must agree on the prime count.
+//
+//   g++ -std=c++20 -O2 -pthread StarPrimeBench.cpp -o StarPrimeBench
+//   ./StarPrimeBench [count]
+
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+#include "../star_math.h"
+
+using namespace STAR_CPP;
+using namespace STAR_CPP::extend;
+
+template <typename F>
+static double seconds(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The is_prime this library shipped before the 128-bit and Montgomery paths.
+namespace before {
+	static long long mul_mod(long long a, long long b, long long mod) {
+		long long res = 0;
+		a %= mod;
+		while (b > 0) {
+			if (b & 1) res = (res + a) % mod;
+			a = (a + a) % mod;
+			b >>= 1;
+		}
+		return res;
+	}
+
+	static long long qpow_mod(long long base, long long exp, long long mod) {
+		long long res = 1 % mod;
+		base %= mod;
+		while (exp > 0) {
+			if (exp & 1) res = mul_mod(res, base, mod);
+			base = mul_mod(base, base, mod);
+			exp >>= 1;
+		}
+		return res;
+	}
+
+	static bool is_prime(long long n) {
+		if (n < 2) return false;
+		if (n == 2 || n == 3) return true;
+		if (n % 2 == 0) return false;
+		long long d = n - 1;
+		int s = 0;
+		while ((d & 1) == 0) {
+			d >>= 1;
+			s++;
+		}
+		static const int bases[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+		for (int a : bases) {
+			if (n == a) return true;
+			if (n % a == 0) return false;
+			long long x = qpow_mod(a, d, n);
+			if (x == 1 || x == n - 1) continue;
+			bool composite = true;
+			for (int r = 1; r < s; ++r) {
+				x = mul_mod(x, x, n);
+				if (x == n - 1) {
+					composite = false;
+					break;
+				}
+			}
+			if (composite) return false;
+		}
+		return true;
+	}
+}
+
+template <typename IsPrime>
+static void bench(const char* name, const std::vector<long long>& numbers, IsPrime is_prime) {
+	size_t primes = 0;
+	double elapsed = seconds([&] {
+		for (long long n : numbers) primes += is_prime(n);
+	});
+	std::printf("%-8s %8.3f s  %10.0f numbers/s  (%zu primes)\n",
+		name, elapsed, numbers.size() / elapsed, primes);
+}
+
+int main(int argc, char** argv) {
+	size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	SplitMix64Rand engine(1);
+	std::vector<long long> numbers(count);
+	for (long long& n : numbers) n = static_cast<long long>(engine() >> 2);
+
+	std::vector<long long> primes;
+	while (primes.size() < count / 100 + 1) {
+		long long n = static_cast<long long>(engine() >> 2) | 1;
+		if (Math<long long>::is_prime(n)) primes.push_back(n);
+	}
+
+	std::printf("%zu random 62-bit numbers\n", numbers.size());
+	bench("before", numbers, before::is_prime);
+	bench("after", numbers, Math<long long>::is_prime);
+	std::printf("%zu random 62-bit primes\n", primes.size());
+	bench("before", primes, before::is_prime);
+	bench("after", primes, Math<long long>::is_prime);
+	return 0;
+}
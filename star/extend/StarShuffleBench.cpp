@@ -0,0 +1,88 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+// Shuffle throughput on int arrays: std::shuffle with std::mt19937_64 against
+// batched_shuffle and merge_shuffle at 1, 2, 4, ... threads (up to 4 or the core
+// count, whichever is larger). Small arrays are shuffled `repeats` times, large
+// arrays once; times are totals in seconds.
+//
+//   g++ -std=c++20 -O2 -pthread StarShuffleBench.cpp -o StarShuffleBench
+//   ./StarShuffleBench [small] [repeats] [large]
+
+#include<algorithm>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<numeric>
+#include<random>
+#include<thread>
+#include<vector>
+#include "../star_permutation.h"
+
+using namespace STAR_CPP;
+using namespace STAR_CPP::extend;
+
+template <typename F>
+static double seconds(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void bench(size_t n, size_t repeats) {
+	std::vector<int> a(n);
+	std::iota(a.begin(), a.end(), 0);
+	long long sink = 0;
+	auto report = [&](const char* name, double elapsed) {
+		sink += a[n / 2];
+		std::printf("  %-28s %8.3f s\n", name, elapsed);
+	};
+
+	std::printf("n = %zu, %zu run(s)\n", n, repeats);
+	std::mt19937_64 mt(1);
+	report("std::shuffle (mt19937_64)", seconds([&] {
+		for (size_t r = 0; r < repeats; ++r) std::shuffle(a.begin(), a.end(), mt);
+	}));
+	std::mt19937_64 mt_batched(1);
+	report("batched_shuffle (mt19937_64)", seconds([&] {
+		for (size_t r = 0; r < repeats; ++r) batched_shuffle(a.begin(), a.end(), mt_batched);
+	}));
+	SplitMix64Rand sm(1);
+	report("batched_shuffle (SplitMix64)", seconds([&] {
+		for (size_t r = 0; r < repeats; ++r) batched_shuffle(a.begin(), a.end(), sm);
+	}));
+
+	unsigned max_threads = std::max(4u, std::thread::hardware_concurrency());
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		char name[64];
+		std::snprintf(name, sizeof(name), "merge_shuffle, %u thread(s)", threads);
+		SplitMix64Rand base(1);
+		report(name, seconds([&] {
+			for (size_t r = 0; r < repeats; ++r) merge_shuffle(a.begin(), a.end(), base.stream(r), threads);
+		}));
+	}
+	std::printf("  (%lld)\n", sink % 10);
+}
+
+int main(int argc, char** argv) {
+	size_t small = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+	size_t repeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+	size_t large = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100000000;
+	if (small > 0) bench(small, repeats);
+	if (large > 0) bench(large, 1);
+	return 0;
+}
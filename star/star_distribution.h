@@ -0,0 +1,729 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+#ifndef STAR_DISTRIBUTION_H
+#define STAR_DISTRIBUTION_H
+
+#include<cstdint>
+#include<cmath>
+#include<complex>
+#include<numbers>
+#include<cstring>
+#include<string>
+#include<string_view>
+#include<vector>
+#include<stdexcept>
+#include<type_traits>
+#include "extend/StarExtendedRandomEngine.h"
+
+namespace STAR_CPP {
+
+	// Turns any UniformRandomBitGenerator into a source of uniform 32/64-bit words.
+	// Engines whose range is not a power of two (e.g. MinstdLCG) are sampled in
+	// smaller chunks with rejection, so the words stay exactly uniform.
+	template <typename Engine>
+	class RandomBits {
+	private:
+		static constexpr uint64_t SPAN = uint64_t(Engine::max()) - uint64_t(Engine::min());
+
+		static constexpr int floor_log2(uint64_t x) {
+			int r = 0;
+			while (x >>= 1) ++r;
+			return r;
+		}
+
+		static constexpr bool FULL64 = SPAN == ~uint64_t(0);
+		static constexpr bool POW2 = FULL64 || ((SPAN + 1) & SPAN) == 0;
+		static constexpr int CHUNK_BITS = FULL64 ? 64 : (POW2 ? floor_log2(SPAN + 1) : (floor_log2(SPAN + 1) > 8 ? floor_log2(SPAN + 1) - 8 : 1));
+		static constexpr uint64_t LIMIT = FULL64 ? 0 : ((SPAN + 1) >> CHUNK_BITS) << CHUNK_BITS;
+
+		static uint64_t chunk(Engine& engine) {
+			uint64_t v = uint64_t(engine()) - uint64_t(Engine::min());
+			if constexpr (!POW2) {
+				while (v >= LIMIT) v = uint64_t(engine()) - uint64_t(Engine::min());
+			}
+			if constexpr (CHUNK_BITS == 64) return v;
+			else return v & ((uint64_t(1) << CHUNK_BITS) - 1);
+		}
+
+		template <int Bits>
+		static uint64_t collect(Engine& engine) {
+			if constexpr (CHUNK_BITS >= Bits) {
+				return chunk(engine) >> (CHUNK_BITS - Bits);
+			} else {
+				uint64_t word = 0;
+				for (int have = 0; have < Bits; ) {
+					int take = Bits - have < CHUNK_BITS ? Bits - have : CHUNK_BITS;
+					word = (word << take) | (chunk(engine) >> (CHUNK_BITS - take));
+					have += take;
+				}
+				return word;
+			}
+		}
+
+	public:
+		static uint64_t next64(Engine& engine) {
+			return collect<64>(engine);
+		}
+
+		static uint32_t next32(Engine& engine) {
+			return static_cast<uint32_t>(collect<32>(engine));
+		}
+	};
+
+	// Bounded integers by Lemire's multiply-shift method ("Fast Random Integer
+	// Generation in an Interval", 2019). The result is defined by this code alone,
+	// so every standard library produces the same sequence.
+	template <typename T>
+	class UniformInt {
+	private:
+		static_assert(std::is_integral_v<T>, "UniformInt requires an integral type");
+		using U = std::make_unsigned_t<T>;
+		using W = std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>;
+
+		T lo;
+		W range;
+
+	public:
+		using result_type = T;
+
+		// The difference is taken in W: for types narrower than int, U would promote
+		// to int and a negative min would wrap the range to about 2^32.
+		constexpr UniformInt(T min, T max) : lo(min), range(static_cast<W>(static_cast<W>(max) - static_cast<W>(min)) + 1) {}
+
+		constexpr T min() const { return lo; }
+		constexpr T max() const { return static_cast<T>(static_cast<U>(lo) + static_cast<U>(range - 1)); }
+
+		template <typename Engine>
+		T operator()(Engine& engine) const {
+			return static_cast<T>(static_cast<U>(lo) + static_cast<U>(bounded(engine, range)));
+		}
+
+		// Uniform value in [0, range); range == 0 stands for the full 2^32 / 2^64.
+		template <typename Engine>
+		static W bounded(Engine& engine, W range) {
+			if constexpr (sizeof(W) == 4) {
+				uint32_t x = RandomBits<Engine>::next32(engine);
+				if (range == 0) return x;
+				uint64_t m = uint64_t(x) * range;
+				uint32_t l = static_cast<uint32_t>(m);
+				if (l < range) {
+					uint32_t t = static_cast<uint32_t>(-range) % range;
+					while (l < t) {
+						x = RandomBits<Engine>::next32(engine);
+						m = uint64_t(x) * range;
+						l = static_cast<uint32_t>(m);
+					}
+				}
+				return static_cast<uint32_t>(m >> 32);
+			} else {
+				uint64_t x = RandomBits<Engine>::next64(engine);
+				if (range == 0) return x;
+				uint64_t high;
+				uint64_t l = extend::mul128(x, range, &high);
+				if (l < range) {
+					uint64_t t = (0 - range) % range;
+					while (l < t) {
+						x = RandomBits<Engine>::next64(engine);
+						l = extend::mul128(x, range, &high);
+					}
+				}
+				return high;
+			}
+		}
+	};
+
+	// Uniform double in [0, 1) from the top 53 bits of one 64-bit word.
+	template <typename Engine>
+	inline double uniform01(Engine& engine) {
+		return double(RandomBits<Engine>::next64(engine) >> 11) * 0x1.0p-53;
+	}
+
+	class UniformReal {
+	private:
+		double lo, width;
+
+	public:
+		using result_type = double;
+
+		UniformReal(double min = 0.0, double max = 1.0) : lo(min), width(max - min) {}
+
+		template <typename Engine>
+		double operator()(Engine& engine) const {
+			return uniform01(engine) * width + lo;
+		}
+	};
+
+	// 256-layer ziggurat tables (Marsaglia & Tsang, 2000). x[0] is the width of
+	// the base strip's rectangle of equal area, x[1] = R and x[256] = 0.
+	struct ZigguratTable {
+		double x[257];
+		double f[257];
+
+		template <typename Pdf, typename InversePdf>
+		ZigguratTable(double r, double v, Pdf pdf, InversePdf inverse) {
+			x[0] = v / pdf(r);
+			x[1] = r;
+			for (int i = 1; i < 255; ++i) x[i + 1] = inverse(pdf(x[i]) + v / x[i]);
+			x[256] = 0.0;
+			for (int i = 0; i < 256; ++i) f[i] = pdf(x[i]);
+			f[256] = 1.0;
+		}
+	};
+
+	class Normal {
+	private:
+		double mean, stddev;
+
+		static const ZigguratTable& table() {
+			static const ZigguratTable t(3.6541528853610088, 0.00492867323399,
+				[](double x) { return std::exp(-0.5 * x * x); },
+				[](double y) { return std::sqrt(-2.0 * std::log(y)); });
+			return t;
+		}
+
+	public:
+		using result_type = double;
+
+		Normal(double mean = 0.0, double stddev = 1.0) : mean(mean), stddev(stddev) {}
+
+		template <typename Engine>
+		double operator()(Engine& engine) const {
+			return mean + stddev * standard(engine);
+		}
+
+		template <typename Engine>
+		static double standard(Engine& engine) {
+			static constexpr double R = 3.6541528853610088;
+			const ZigguratTable& t = table();
+			while (true) {
+				uint64_t bits = RandomBits<Engine>::next64(engine);
+				int i = static_cast<int>(bits & 0xff);
+				double u = 2.0 * (double(bits >> 11) * 0x1.0p-53) - 1.0;
+				double x = u * t.x[i];
+				if (std::fabs(x) < t.x[i + 1]) return x;
+				if (i == 0) {
+					double tail, y;
+					do {
+						tail = -std::log(1.0 - uniform01(engine)) / R;
+						y = -std::log(1.0 - uniform01(engine));
+					} while (y + y < tail * tail);
+					return u < 0 ? -(R + tail) : R + tail;
+				}
+				if (t.f[i + 1] + (t.f[i] - t.f[i + 1]) * uniform01(engine) < std::exp(-0.5 * x * x)) return x;
+			}
+		}
+	};
+
+	class Exponential {
+	private:
+		double lambda;
+
+		static const ZigguratTable& table() {
+			static const ZigguratTable t(7.69711747013104972, 0.0039496598225815571993,
+				[](double x) { return std::exp(-x); },
+				[](double y) { return -std::log(y); });
+			return t;
+		}
+
+	public:
+		using result_type = double;
+
+		explicit Exponential(double lambda = 1.0) : lambda(lambda) {}
+
+		template <typename Engine>
+		double operator()(Engine& engine) const {
+			return standard(engine) / lambda;
+		}
+
+		template <typename Engine>
+		static double standard(Engine& engine) {
+			static constexpr double R = 7.69711747013104972;
+			const ZigguratTable& t = table();
+			while (true) {
+				uint64_t bits = RandomBits<Engine>::next64(engine);
+				int i = static_cast<int>(bits & 0xff);
+				double x = (double(bits >> 11) * 0x1.0p-53) * t.x[i];
+				if (x < t.x[i + 1]) return x;
+				if (i == 0) return R - std::log(1.0 - uniform01(engine));
+				if (t.f[i + 1] + (t.f[i] - t.f[i + 1]) * uniform01(engine) < std::exp(-x)) return x;
+			}
+		}
+	};
+
+	// Multiplication inversion for small means, Hormann's PTRS
+	// ("The transformed rejection method for generating Poisson random variables", 1993) otherwise.
+	class Poisson {
+	private:
+		double mu;
+		double exp_neg_mu, log_mu, b, a, log_inv_alpha, v_r;
+
+	public:
+		using result_type = long long;
+
+		explicit Poisson(double mean = 1.0) : mu(mean) {
+			exp_neg_mu = std::exp(-mu);
+			log_mu = std::log(mu);
+			b = 0.931 + 2.53 * std::sqrt(mu);
+			a = -0.059 + 0.02483 * b;
+			log_inv_alpha = std::log(1.1239 + 1.1328 / (b - 3.4));
+			v_r = 0.9277 - 3.6224 / (b - 2.0);
+		}
+
+		template <typename Engine>
+		long long operator()(Engine& engine) const {
+			if (mu <= 0.0) return 0;
+			if (mu < 10.0) {
+				long long k = 0;
+				double prod = uniform01(engine);
+				while (prod > exp_neg_mu) {
+					++k;
+					prod *= uniform01(engine);
+				}
+				return k;
+			}
+			while (true) {
+				double u = uniform01(engine) - 0.5;
+				double v = uniform01(engine);
+				double us = 0.5 - std::fabs(u);
+				long long k = static_cast<long long>(std::floor((2.0 * a / us + b) * u + mu + 0.43));
+				if (us >= 0.07 && v <= v_r) return k;
+				if (k < 0 || (us < 0.013 && v > us)) continue;
+				if (std::log(v) + log_inv_alpha - std::log(a / (us * us) + b) <= -mu + k * log_mu - std::lgamma(k + 1.0)) return k;
+			}
+		}
+	};
+
+	// Inversion when n * min(p, 1 - p) < 10, Hormann's BTRS
+	// ("The generation of binomial random variates", 1993) otherwise.
+	class Binomial {
+	private:
+		long long n;
+		double p;
+		bool flipped;
+		double q, r, a_inv, b, a, c, v_r, alpha, m, q_pow_n;
+
+		static double stirling_tail(double k) {
+			static const double table[10] = {
+				0.0810614667953272, 0.0413406959554092, 0.0276779256849983, 0.02079067210376509, 0.0166446911898211,
+				0.0138761288230707, 0.0118967099458917, 0.0104112652619720, 0.00925546218271273, 0.00833056343336287
+			};
+			if (k <= 9) return table[static_cast<int>(k)];
+			double kp1sq = (k + 1) * (k + 1);
+			return (1.0 / 12 - (1.0 / 360 - 1.0 / 1260 / kp1sq) / kp1sq) / (k + 1);
+		}
+
+		template <typename Engine>
+		long long inversion(Engine& engine) const {
+			while (true) {
+				double u = uniform01(engine);
+				double prob = q_pow_n;
+				long long x = 0;
+				while (u > prob && x <= n) {
+					u -= prob;
+					++x;
+					prob *= a_inv / x - r;
+				}
+				if (x <= n) return x;
+			}
+		}
+
+		template <typename Engine>
+		long long btrs(Engine& engine) const {
+			while (true) {
+				double u = uniform01(engine) - 0.5;
+				double v = uniform01(engine);
+				double us = 0.5 - std::fabs(u);
+				double k = std::floor((2.0 * a / us + b) * u + c);
+				if (k < 0 || k > n) continue;
+				if (us >= 0.07 && v <= v_r) return static_cast<long long>(k);
+				v = std::log(v * alpha / (a / (us * us) + b));
+				double nd = static_cast<double>(n);
+				double bound = (m + 0.5) * std::log((m + 1) / (r * (nd - m + 1)))
+					+ (nd + 1) * std::log((nd - m + 1) / (nd - k + 1))
+					+ (k + 0.5) * std::log(r * (nd - k + 1) / (k + 1))
+					+ stirling_tail(m) + stirling_tail(nd - m) - stirling_tail(k) - stirling_tail(nd - k);
+				if (v <= bound) return static_cast<long long>(k);
+			}
+		}
+
+	public:
+		using result_type = long long;
+
+		Binomial(long long trials = 1, double prob = 0.5) : n(trials), p(prob), flipped(prob > 0.5) {
+			if (flipped) p = 1.0 - p;
+			q = 1.0 - p;
+			r = p / q;
+			a_inv = (n + 1) * r;
+			q_pow_n = std::pow(q, static_cast<double>(n));
+			double stddev = std::sqrt(n * p * q);
+			b = 1.15 + 2.53 * stddev;
+			a = -0.0873 + 0.0248 * b + 0.01 * p;
+			c = n * p + 0.5;
+			v_r = 0.92 - 4.2 / b;
+			alpha = (2.83 + 5.1 / b) * stddev;
+			m = std::floor((n + 1) * p);
+		}
+
+		template <typename Engine>
+		long long operator()(Engine& engine) const {
+			if (n <= 0 || p <= 0.0) return flipped ? n : 0;
+			long long k = n * p < 10.0 ? inversion(engine) : btrs(engine);
+			return flipped ? n - k : k;
+		}
+	};
+
+	// Number of failures before the first success, by inversion.
+	class Geometric {
+	private:
+		double log_q;
+
+	public:
+		using result_type = long long;
+
+		explicit Geometric(double p = 0.5) : log_q(std::log1p(-p)) {}
+
+		template <typename Engine>
+		long long operator()(Engine& engine) const {
+			if (log_q == -HUGE_VAL) return 0;
+			return static_cast<long long>(std::floor(std::log(1.0 - uniform01(engine)) / log_q));
+		}
+	};
+
+	// P(S = t) for an integer-valued S, by the trapezoid rule on the inversion
+	// integral of its characteristic function. With `period` nodes the rule returns
+	// the sum of P(S = t + m * period) over all m, so the period is made wider than
+	// the 40-sigma range (or the whole support) and is exact to rounding. log_cf(w)
+	// is log E[exp(iw(S - mean))]; nodes past omega_max are negligible by assumption.
+	// Only for log-concave S, whose tails beyond 40 sigma are below 1e-16.
+	template <typename LogCf>
+	double lattice_pmf(long double t, long double mean, double sd, long double support, double omega_max, LogCf log_cf) {
+		long double offset = mean - t;
+		if (std::fabs(offset) > 40.0L * sd + 1.0L) return 0.0;
+		double period = double(std::min(support, std::ceil(80.0L * sd + 66.0L)));
+		double step = 2.0 * std::numbers::pi / period;
+		double sum = 1.0;
+		for (double j = 1.0; 2.0 * j <= period && j * step <= omega_max; j += 1.0) {
+			double w = j * step;
+			std::complex<double> l = log_cf(w);
+			double term = std::exp(l.real()) * std::cos(l.imag() + double(offset) * w);
+			sum += 2.0 * j == period ? term : 2.0 * term;
+		}
+		return std::max(0.0, sum / period);
+	}
+
+	// P(j) proportional to exp(-lambda * j) on [0, cap], by inversion; lambda = 0 is
+	// uniform. sum_pmf gives the exact law of a sum of independent draws.
+	class TruncatedGeometric {
+	private:
+		double lambda;
+		uint64_t cap;
+		double tail, mu, var;
+
+		// log |E[exp(iwX)]| is at most this, and the bound decreases on (0, pi].
+		double log_envelope(double w) const {
+			double s = std::sin(0.5 * w);
+			if (lambda == 0.0) return std::min(0.0, -std::log((double(cap) + 1.0) * s));
+			double x = std::exp(-lambda), d = -std::expm1(-lambda), a = 1.0 - tail;
+			return std::min(0.0, std::log((1.0 + a) / tail) - 0.5 * std::log1p(4.0 * x * s * s / (d * d)));
+		}
+
+		// log E[exp(iw(X - mean))], arranged to stay accurate for small w.
+		std::complex<double> log_cf(double w) const {
+			double c1 = double(cap) + 1.0;
+			if (lambda == 0.0) {
+				double r = std::sin(0.5 * c1 * w) / (c1 * std::sin(0.5 * w));
+				return { std::log(std::fabs(r)), r < 0.0 ? std::numbers::pi : 0.0 };
+			}
+			double x = std::exp(-lambda), d = -std::expm1(-lambda), a = 1.0 - tail, alpha = c1 * w;
+			double sa = std::sin(0.5 * alpha), sw = std::sin(0.5 * w);
+			double magnitude = 0.5 * (std::log1p(4.0 * a * sa * sa / (tail * tail)) - std::log1p(4.0 * x * sw * sw / (d * d)));
+			double phase = std::atan2(-a * std::sin(alpha), tail + 2.0 * a * sa * sa) - std::atan2(-x * std::sin(w), d + 2.0 * x * sw * sw);
+			return { magnitude, phase - mu * w };
+		}
+
+	public:
+		using result_type = uint64_t;
+
+		TruncatedGeometric(double lambda, uint64_t cap) : lambda(lambda), cap(cap) {
+			double c1 = double(cap) + 1.0;
+			if (lambda == 0.0) {
+				tail = 1.0;
+				mu = 0.5 * double(cap);
+				var = double(cap) * (double(cap) + 2.0) / 12.0;
+			} else {
+				tail = -std::expm1(-lambda * c1);
+				double e1 = std::expm1(lambda), q = c1 / std::expm1(lambda * c1);
+				mu = 1.0 / e1 - q;
+				var = 1.0 / e1 + 1.0 / (e1 * e1) - c1 * q - q * q;
+			}
+		}
+
+		double mean() const { return mu; }
+		double variance() const { return var; }
+
+		template <typename Engine>
+		uint64_t operator()(Engine& engine) const {
+			if (lambda == 0.0) return UniformInt<uint64_t>(0, cap)(engine);
+			double j = std::floor(-std::log1p(-uniform01(engine) * tail) / lambda);
+			return j >= double(cap) ? cap : uint64_t(j);
+		}
+
+		// P(X_1 + ... + X_h = t) for h independent draws.
+		double sum_pmf(uint64_t h, uint64_t t) const {
+			long double support = (long double)h * cap + 1.0L;
+			if ((long double)t >= support) return 0.0;
+			double hd = double(h), omega_max = std::numbers::pi;
+			if (hd * log_envelope(omega_max) < -42.0) {
+				double lo = 0.0;
+				for (int it = 0; it < 60; ++it) {
+					double mid = 0.5 * (lo + omega_max);
+					(hd * log_envelope(mid) < -42.0 ? omega_max : lo) = mid;
+				}
+			}
+			return lattice_pmf((long double)t, (long double)h * mu, std::sqrt(hd * var), support, omega_max,
+				[&](double w) { return hd * log_cf(w); });
+		}
+	};
+
+	// How many of 1..r open a new cycle in the Feller coupling, where i does so with
+	// probability theta / (theta + i) independently; theta = 1 is a uniform permutation.
+	// pmf gives the exact law of that count. Construction is O(r), pmf O(sd).
+	class CycleStarts {
+	private:
+		double theta, r, base, mu = 0.0, var = 0.0, omega_max = std::numbers::pi;
+
+		// log of w (w + 1) ... (w + r - 1), modulo 2 pi i. Factors left of the imaginary
+		// axis are reflected, (w)_k = (-1)^k (1 - w - k)_k, and long runs use Stirling.
+		static std::complex<double> log_rising(std::complex<double> w, double r) {
+			std::complex<double> sum = 0.0;
+			if (w.real() < 0.0) {
+				double k = std::min(r, std::ceil(-w.real()));
+				sum = log_rising(1.0 - w - k, k) + std::complex<double>(0.0, std::fmod(k, 2.0) * std::numbers::pi);
+				w += k;
+				r -= k;
+			}
+			for (; r > 0.0 && std::abs(w) < 16.0; r -= 1.0, w += 1.0) sum += std::log(w);
+			if (r <= 0.0) return sum;
+			auto series = [](std::complex<double> z) {
+				std::complex<double> y = 1.0 / (z * z);
+				return (1.0 / 12.0 - y * (1.0 / 360.0 - y * (1.0 / 1260.0 - y / 1680.0))) / z;
+			};
+			std::complex<double> u = r / w, z = w + r, ratio;
+			if (std::abs(u) < 0.5) {
+				ratio = { 0.5 * std::log1p(2.0 * u.real() + std::norm(u)), std::atan2(u.imag(), 1.0 + u.real()) };
+			} else {
+				ratio = std::log(z) - std::log(w);
+			}
+			return sum + (w - 0.5) * ratio + r * std::log(z) - r + series(z) - series(w);
+		}
+
+		// log E[exp(iw(X - mean))]; its real part decreases on (0, pi].
+		std::complex<double> log_cf(double w) const {
+			std::complex<double> l = log_rising(1.0 + std::polar(theta, w), r);
+			return { l.real() - base, l.imag() - mu * w };
+		}
+
+	public:
+		CycleStarts(double theta, uint64_t count) : theta(theta), r(double(count)) {
+			for (uint64_t i = 1; i <= count; ++i) {
+				double p = theta / (theta + double(i));
+				mu += p;
+				var += p * (1.0 - p);
+			}
+			base = log_rising(1.0 + theta, r).real();
+			if (log_cf(omega_max).real() < -42.0) {
+				double lo = 0.0;
+				for (int it = 0; it < 60; ++it) {
+					double mid = 0.5 * (lo + omega_max);
+					(log_cf(mid).real() < -42.0 ? omega_max : lo) = mid;
+				}
+			}
+		}
+
+		double mean() const { return mu; }
+
+		// P(exactly t of 1..r open a cycle).
+		double pmf(uint64_t t) const {
+			if (double(t) > r) return 0.0;
+			return lattice_pmf((long double)t, (long double)mu, std::sqrt(var), (long double)r + 1.0L, omega_max,
+				[&](double w) { return log_cf(w); });
+		}
+	};
+
+	// Vose's alias method: O(n) construction, O(1) draws. After update() the table
+	// switches to a Fenwick tree over the live weights (O(log n) draws and updates)
+	// until rebuild() restores the alias form.
+	class AliasTable {
+	private:
+		std::vector<double> weights;
+		std::vector<double> prob;
+		std::vector<size_t> alias;
+		std::vector<double> tree;
+		double total = 0.0;
+		bool dynamic = false;
+
+		void build_alias() {
+			size_t n = weights.size();
+			prob.assign(n, 0.0);
+			alias.assign(n, 0);
+			std::vector<size_t> small, large;
+			std::vector<double> scaled(n);
+			for (size_t i = 0; i < n; ++i) {
+				scaled[i] = weights[i] * n / total;
+				(scaled[i] < 1.0 ? small : large).push_back(i);
+			}
+			while (!small.empty() && !large.empty()) {
+				size_t s = small.back(), l = large.back();
+				small.pop_back();
+				prob[s] = scaled[s];
+				alias[s] = l;
+				scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+				if (scaled[l] < 1.0) {
+					large.pop_back();
+					small.push_back(l);
+				}
+			}
+			for (size_t i : large) prob[i] = 1.0;
+			for (size_t i : small) prob[i] = 1.0;
+			tree.clear();
+			dynamic = false;
+		}
+
+		void build_tree() {
+			size_t n = weights.size();
+			tree.assign(n + 1, 0.0);
+			for (size_t i = 1; i <= n; ++i) {
+				tree[i] += weights[i - 1];
+				size_t parent = i + (i & (0 - i));
+				if (parent <= n) tree[parent] += tree[i];
+			}
+			dynamic = true;
+		}
+
+		template <typename Engine>
+		size_t sample_tree(Engine& engine) const {
+			size_t n = weights.size();
+			size_t step = 1;
+			while (step * 2 <= n) step *= 2;
+			while (true) {
+				double u = uniform01(engine) * total;
+				size_t pos = 0;
+				for (size_t k = step; k > 0; k >>= 1) {
+					if (pos + k <= n && tree[pos + k] <= u) {
+						pos += k;
+						u -= tree[pos];
+					}
+				}
+				if (pos < n && weights[pos] > 0.0) return pos;
+			}
+		}
+
+	public:
+		using result_type = size_t;
+
+		AliasTable() = default;
+
+		explicit AliasTable(const std::vector<double>& w) : weights(w) {
+			if (weights.empty()) throw std::invalid_argument("Empty weights");
+			for (double x : weights) {
+				if (!(x >= 0.0)) throw std::invalid_argument("Weights must be non-negative");
+				total += x;
+			}
+			if (!(total > 0.0)) throw std::invalid_argument("Weights sum to zero");
+			build_alias();
+		}
+
+		size_t size() const { return weights.size(); }
+		double weight(size_t i) const { return weights[i]; }
+		double total_weight() const { return total; }
+
+		void update(size_t i, double w) {
+			if (!(w >= 0.0)) throw std::invalid_argument("Weights must be non-negative");
+			if (!dynamic) build_tree();
+			double delta = w - weights[i];
+			weights[i] = w;
+			total += delta;
+			for (size_t j = i + 1; j < tree.size(); j += j & (0 - j)) tree[j] += delta;
+		}
+
+		void rebuild() {
+			total = 0.0;
+			for (double x : weights) total += x;
+			if (!(total > 0.0)) throw std::invalid_argument("Weights sum to zero");
+			build_alias();
+		}
+
+		template <typename Engine>
+		size_t operator()(Engine& engine) const {
+			if (dynamic) return sample_tree(engine);
+			size_t i = UniformInt<size_t>(0, weights.size() - 1)(engine);
+			return uniform01(engine) < prob[i] ? i : alias[i];
+		}
+	};
+
+	// Fills character buffers from a charset, slicing each 64-bit word into
+	// ceil(log2(|charset|))-bit indices. Indices past the charset are rejected so
+	// the output stays unbiased; the table is padded to a power of two so the
+	// rejection is a branch-free advance.
+	class CharsetSampler {
+	private:
+		std::string table;
+		uint64_t count = 0;
+		unsigned bits = 0;
+
+	public:
+		explicit CharsetSampler(std::string_view charset) : count(charset.size()) {
+			if (charset.empty()) throw std::invalid_argument("Empty charset");
+			while ((uint64_t(1) << bits) < count) ++bits;
+			table.assign(size_t(1) << bits, charset[0]);
+			std::memcpy(table.data(), charset.data(), charset.size());
+		}
+
+		size_t size() const { return count; }
+
+		template <typename Engine>
+		void operator()(Engine& engine, char* out, size_t n) const {
+			if (bits == 0) {
+				std::memset(out, table[0], n);
+				return;
+			}
+			const uint64_t mask = (uint64_t(1) << bits) - 1;
+			const unsigned per_word = 64 / bits;
+			const char* lut = table.data();
+			size_t i = 0;
+			while (n - i >= per_word) {
+				uint64_t word = RandomBits<Engine>::next64(engine);
+				for (unsigned k = 0; k < per_word; ++k, word >>= bits) {
+					uint64_t idx = word & mask;
+					out[i] = lut[idx];
+					i += idx < count;
+				}
+			}
+			while (i < n) {
+				uint64_t word = RandomBits<Engine>::next64(engine);
+				for (unsigned k = 0; k < per_word && i < n; ++k, word >>= bits) {
+					uint64_t idx = word & mask;
+					if (idx < count) out[i++] = lut[idx];
+				}
+			}
+		}
+	};
+
+}
+
+#endif
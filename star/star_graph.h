@@ -25,17 +25,17 @@ TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
 
 namespace STAR_CPP {
 	
-	template <typename Engine, typename Node = int, typename Weight = long long>
+	template <typename Engine, typename Node = int, typename Weight = long long, typename Lock = std::mutex>
 	class Graph {
 	private:
-		Random<Engine> rng;
+		Random<Engine, Lock> rng;
 		
 		std::vector<Node> selectNodes(Node limit, Node count) {
 			if (limit < 1 || count < 1 || count > limit) return {};
-			std::vector<Node> pool;
-			for (Node i = 1; i <= limit; i++) pool.push_back(i);
-			rng.shuffle(pool);
-			return std::vector<Node>(pool.begin(), pool.begin() + (int)count);
+			FeistelPermutation perm = rng.lazy_permutation((uint64_t)limit);
+			std::vector<Node> nodes((size_t)count);
+			for (size_t i = 0; i < nodes.size(); i++) nodes[i] = Node(perm[i] + 1);
+			return nodes;
 		}
 		
 	public:
@@ -71,16 +71,9 @@ namespace STAR_CPP {
 		
 		std::vector<Edge> randomForest(Node n, int components) {
 			if (n <= 0 || components <= 0 || components > n) return {};
-			std::vector<Node> pool(n);
-			for (Node i = 0; i < n; ++i) pool[i] = i + 1;
-			rng.shuffle(pool);
+			FeistelPermutation pool = rng.lazy_permutation((uint64_t)n);
 			
-			std::vector<int> sizes(components);
-			std::fill(sizes.begin(), sizes.end(), 1);
-			int remaining = n - components;
-			for (int i = 0; i < remaining; ++i) {
-				sizes[rng.randint(0, components - 1)]++;
-			}
+			std::vector<int> sizes = rng.composition((int)n, (size_t)components);
 			
 			std::vector<Edge> all_edges;
 			Node id_offset = 1;
@@ -91,7 +84,7 @@ namespace STAR_CPP {
 					continue;
 				}
 				std::vector<Node> component_nodes;
-				for (int j = 0; j < sz; ++j) component_nodes.push_back(pool[(int)id_offset - 1 + j]);
+				for (int j = 0; j < sz; ++j) component_nodes.push_back(Node(pool[(uint64_t)id_offset - 1 + j] + 1));
 				
 				for (int idx = 1; idx < sz; idx++) {
 					int p_idx = rng.randint(0, idx - 1);
@@ -177,7 +170,7 @@ namespace STAR_CPP {
 		std::vector<Edge> strictLayered(Node n, int m, int k) {
 			if (n <= 0 || k <= 1) return {};
 			std::vector<int> layer((int)n + 1);
-			for (int i = 1; i <= (int)n; ++i) layer[i] = rng.randint(0, k - 1);
+			rng.randint_fill(std::span<int>(layer).subspan(1), 0, k - 1);
 			std::vector<int> count_in_layer(k, 0);
 			for (int i = 1; i <= (int)n; ++i) count_in_layer[layer[i]]++;
 			int max_possible = 0;
@@ -205,9 +198,11 @@ namespace STAR_CPP {
 			if (n <= 0 || max_deg <= 0) return {};
 			std::vector<int> deg((int)n + 1, 0);
 			std::vector<Edge> edges;
+			std::vector<double> row((int)n);
 			for (Node u = 1; u <= n; ++u) {
+				rng.random_fill(std::span<double>(row.data(), (size_t)(n - u)));
 				for (Node v = u + 1; v <= n; ++v) {
-					if (rng.random(0.0, 1.0) < prob) {
+					if (row[(int)(v - u) - 1] < prob) {
 						if (deg[(int)u] < max_deg && deg[(int)v] < max_deg) {
 							edges.push_back({ u, v });
 							deg[(int)u]++;
@@ -221,9 +216,14 @@ namespace STAR_CPP {
 		
 		std::vector<CostFlowEdge> assignWeights(const std::vector<Edge>& edges, Weight min_w, Weight max_w) {
 			std::vector<CostFlowEdge> res;
-			for (auto& e : edges) {
-				Weight w = (Weight)rng.randint((int)min_w, (int)max_w);
-				res.push_back({ e.first, e.second, Weight(1), w });
+			std::vector<Weight> w;
+			if constexpr (std::is_integral_v<Weight>) w = rng.randint_n(edges.size(), min_w, max_w);
+			else {
+				std::vector<double> r = rng.random_n(edges.size(), (double)min_w, (double)max_w);
+				w.assign(r.begin(), r.end());
+			}
+			for (size_t i = 0; i < edges.size(); ++i) {
+				res.push_back({ edges[i].first, edges[i].second, Weight(1), w[i] });
 			}
 			return res;
 		}
@@ -231,8 +231,9 @@ namespace STAR_CPP {
 		std::vector<CostFlowEdge> metricWeights(Node n) {
 			struct Point { int x, y; };
 			std::vector<Point> pts((int)n + 1);
+			std::vector<int> coords = rng.randint_n(2 * (size_t)n, 0, 10000);
 			for (int i = 1; i <= (int)n; ++i) {
-				pts[i] = { rng.randint(0, 10000), rng.randint(0, 10000) };
+				pts[i] = { coords[2 * i - 2], coords[2 * i - 1] };
 			}
 			std::vector<CostFlowEdge> res;
 			for (Node u = 1; u <= n; ++u) {
@@ -380,9 +381,11 @@ namespace STAR_CPP {
 			if (count <= 0 || id_limit < count) return {};
 			std::vector<Node> nodes = selectNodes(id_limit, count);
 			std::vector<Edge> edges;
+			std::vector<double> row((int)count);
 			for (int u = 0; u < (int)count; u++) {
+				rng.random_fill(std::span<double>(row.data(), (size_t)((int)count - u - 1)));
 				for (int v = u + 1; v < (int)count; v++) {
-					if (rng.random(0.0, 1.0) < prob) {
+					if (row[v - u - 1] < prob) {
 						edges.push_back({ nodes[u], nodes[v] });
 					}
 				}
@@ -401,6 +404,91 @@ namespace STAR_CPP {
 			return edges;
 		}
 		
+		// Uniform binary tree on n nodes (Remy's algorithm on the full binary tree with n
+		// internal nodes, leaves dropped). Nodes are numbered 1..n in preorder; entry i
+		// holds { left, right } children of node i + 1, with 0 for a missing child.
+		std::vector<Edge> randomBinaryTreeChildren(Node n) {
+			if (n <= 0) return {};
+			int total = 2 * (int)n + 1;
+			std::vector<int> parent(total, -1), left(total, -1), right(total, -1);
+			int root = 0, used = 1;
+			for (int k = 1; k <= (int)n; k++) {
+				long long r = rng.randint(0LL, 2LL * used - 1);
+				int x = (int)(r >> 1);
+				bool leaf_left = r & 1;
+				int inner = used++, leaf = used++;
+				int p = parent[x];
+				if (p < 0) root = inner;
+				else (left[p] == x ? left[p] : right[p]) = inner;
+				parent[inner] = p;
+				left[inner] = leaf_left ? leaf : x;
+				right[inner] = leaf_left ? x : leaf;
+				parent[x] = parent[leaf] = inner;
+			}
+			
+			std::vector<int> label(total, 0);
+			std::vector<int> stack = { root };
+			int next = 0;
+			while (!stack.empty()) {
+				int v = stack.back();
+				stack.pop_back();
+				if (left[v] < 0) continue;
+				label[v] = ++next;
+				stack.push_back(right[v]);
+				stack.push_back(left[v]);
+			}
+			
+			std::vector<Edge> children((size_t)n);
+			for (int v = 0; v < total; v++) {
+				if (left[v] < 0) continue;
+				children[label[v] - 1] = { Node(label[left[v]]), Node(label[right[v]]) };
+			}
+			return children;
+		}
+		
+		std::vector<Edge> randomBinaryTree(Node n) {
+			std::vector<Edge> children = randomBinaryTreeChildren(n);
+			std::vector<Edge> edges;
+			edges.reserve(children.size());
+			for (size_t i = 0; i < children.size(); i++) {
+				if (children[i].first != 0) edges.push_back({ Node(i + 1), children[i].first });
+				if (children[i].second != 0) edges.push_back({ Node(i + 1), children[i].second });
+			}
+			return edges;
+		}
+		
+		// Uniform full k-ary tree on n nodes ((n - 1) divisible by k): a shuffled
+		// Lukasiewicz word rotated by the cycle lemma, decoded in preorder. O(n).
+		std::vector<Edge> randomFullKaryTree(Node n, int k) {
+			if (n <= 0 || k < 1 || ((int)n - 1) % k != 0) return {};
+			int internal = ((int)n - 1) / k;
+			std::vector<int> word((int)n, -1);
+			std::fill(word.begin(), word.begin() + internal, k - 1);
+			rng.shuffle(word);
+			
+			int sum = 0, low = 0, start = 0;
+			for (int i = 0; i < (int)n; i++) {
+				sum += word[i];
+				if (sum < low) {
+					low = sum;
+					start = i + 1;
+				}
+			}
+			std::rotate(word.begin(), word.begin() + (start % (int)n), word.end());
+			
+			std::vector<Edge> edges;
+			edges.reserve((int)n - 1);
+			std::vector<std::pair<int, int>> open;
+			for (int i = 0; i < (int)n; i++) {
+				if (!open.empty()) {
+					edges.push_back({ Node(open.back().first), Node(i + 1) });
+					if (--open.back().second == 0) open.pop_back();
+				}
+				if (word[i] >= 0) open.push_back({ i + 1, word[i] + 1 });
+			}
+			return edges;
+		}
+		
 		std::vector<Edge> nAryTree(Node n, int k) {
 			if (n <= 0 || k < 1) return {};
 			if (n == 1) return {};
@@ -465,10 +553,13 @@ namespace STAR_CPP {
 		}
 		
 		std::vector<Edge> randomGraph(Node n, double prob) {
+			if (n <= 0) return {};
 			std::vector<Edge> edges;
+			std::vector<double> row((int)n);
 			for (Node u = 1; u <= n; u++) {
+				rng.random_fill(std::span<double>(row.data(), (size_t)(n - u)));
 				for (Node v = u + 1; v <= n; v++) {
-					if (rng.random(0.0, 1.0) < prob) {
+					if (row[(int)(v - u) - 1] < prob) {
 						edges.push_back({ u, v });
 					}
 				}
@@ -545,9 +636,12 @@ namespace STAR_CPP {
 		std::vector<Edge> randomBipartite(Node n, int m, double prob) {
 			std::vector<Edge> edges;
 			int split = (int)n / 2;
+			if (split <= 0) return edges;
+			std::vector<double> row((int)n - split);
 			for (Node u = 1; u <= split; u++) {
+				rng.random_fill(row);
 				for (Node v = split + 1; v <= n; v++) {
-					if (rng.random(0.0, 1.0) < prob) edges.push_back({ u, v });
+					if (row[(int)v - split - 1] < prob) edges.push_back({ u, v });
 				}
 			}
 			return edges;
@@ -568,7 +662,7 @@ namespace STAR_CPP {
 		
 		std::vector<Edge> randomLayered(Node n, int m, int k) {
 			std::vector<int> layer((int)n + 1);
-			for (int i = 1; i <= (int)n; i++) layer[i] = rng.randint(0, k - 1);
+			rng.randint_fill(std::span<int>(layer).subspan(1), 0, k - 1);
 			std::vector<Edge> edges;
 			while ((int)edges.size() < m) {
 				int u = rng.randint(1, (int)n);
@@ -580,11 +674,13 @@ namespace STAR_CPP {
 		
 		std::vector<Edge> randomChordal(Node n, double prob) {
 			std::vector<Edge> edges;
+			std::vector<double> row(n > 0 ? (int)n : 0);
 			for (Node i = 1; i <= n; i++) {
+				rng.random_fill(std::span<double>(row.data(), (size_t)(n - i)));
 				for (Node j = i + 1; j <= n; ++j) {
-					if (rng.random(0.0, 1.0) < prob) edges.push_back({ i, j });
+					if (row[(int)(j - i) - 1] < prob) edges.push_back({ i, j });
 				}
-				if (rng.random(0.0, 1.0) < 0.5) {
+				if (i > 1 && rng.random(0.0, 1.0) < 0.5) {
 					int k = rng.randint(1, (int)(i - 1));
 					edges.push_back({ Node(k), i });
 				}
@@ -614,8 +710,10 @@ namespace STAR_CPP {
 				int v = rng.randint(1, (int)n);
 				if (u == v || u == (int)s || v == (int)t) continue;
 				if (existing.count({ Node(u), Node(v) })) continue;
-				int cap_int = rng.randint(1, (int)max_cap);
-				edges.push_back({ Node(u), Node(v), (Weight)cap_int });
+				Weight cap;
+				if constexpr (std::is_integral_v<Weight>) cap = rng.randint(Weight(1), max_cap);
+				else cap = (Weight)rng.randint(1, (int)max_cap);
+				edges.push_back({ Node(u), Node(v), cap });
 				existing.insert({ Node(u), Node(v) });
 			}
 			return edges;
@@ -642,7 +740,7 @@ namespace STAR_CPP {
 			std::set<Node> terminals;
 			std::vector<Node> all_nodes;
 			for (Node i = 1; i <= n; i++) all_nodes.push_back(i);
-			std::vector<Node> t_vec = rng.sample(all_nodes, k);
+			std::vector<Node> t_vec = rng.choices(all_nodes, k);
 			for (Node t : t_vec) terminals.insert(t);
 			std::vector<Edge> edges;
 			std::set<Node> connected;
@@ -692,16 +790,16 @@ namespace STAR_CPP {
 		
 		std::vector<Edge> randomHamiltonianGraph(Node n, double prob) {
 			if (n < 3) return randomCycle(n);
-			std::vector<Node> perm(n);
-			for (int i = 0; i < n; i++) perm[i] = Node(i + 1);
-			rng.shuffle(perm);
+			FeistelPermutation perm = rng.lazy_permutation((uint64_t)n);
 			std::vector<Edge> edges;
 			for (int i = 0; i < n; i++) {
-				edges.push_back({ perm[i], perm[(i + 1) % n] });
+				edges.push_back({ Node(perm[i] + 1), Node(perm[(i + 1) % n] + 1) });
 			}
+			std::vector<double> row((int)n);
 			for (Node u = 1; u <= n; u++) {
+				rng.random_fill(std::span<double>(row.data(), (size_t)(n - u)));
 				for (Node v = u + 1; v <= n; v++) {
-					if (rng.random(0.0, 1.0) < prob) edges.push_back({ u, v });
+					if (row[(int)(v - u) - 1] < prob) edges.push_back({ u, v });
 				}
 			}
 			return edges;
@@ -31,6 +31,8 @@ SOFTWARE.
 #include<thread>
 #include<atomic>
 #include<system_error>
+#include<ranges>
+#include<string>
 
 #include "utils/StarError.h"
 #include "utils/subprocess.h"
@@ -101,6 +103,28 @@ namespace STAR_CPP {
 			_output << data;
 		}
 		
+		// Writes each element of a range (including lazy views) separated by `sep`,
+		// without materializing it.
+		template<std::ranges::input_range R>
+		void input_range(R&& range, const std::string& sep = " ") {
+			bool first = true;
+			for (auto&& x : range) {
+				if (!first) input(sep);
+				input(x);
+				first = false;
+			}
+		}
+
+		template<std::ranges::input_range R>
+		void output_range(R&& range, const std::string& sep = " ") {
+			bool first = true;
+			for (auto&& x : range) {
+				if (!first) output(sep);
+				output(x);
+				first = false;
+			}
+		}
+
 		using func = IO& (*)(IO&);
 		IO& operator<<(func manip) { return manip(*this); }
 		
@@ -20,16 +20,92 @@ TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
 
 #include<algorithm>
 #include<cmath>
+#include<numeric>
+#include<cstdint>
+#include<cstring>
+#include<bit>
+#include<atomic>
+#include<thread>
+#include<vector>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include "extend/StarExtendedRandomEngine.h"
+#include "utils/StarParallel.h"
 
 namespace STAR_CPP {
 	
+	// Montgomery arithmetic for repeated work under one odd 64-bit modulus. Values
+	// passed to mul/pow are in Montgomery form (see to/from), all in [0, mod).
+	class Montgomery {
+	private:
+		uint64_t mod, inv, r1, r2;
+		
+		// (hi:lo) / 2^64 mod `mod` for hi < mod.
+		uint64_t reduce(uint64_t hi, uint64_t lo) const {
+			uint64_t m = lo * inv, mh;
+			extend::mul128(m, mod, &mh);
+			return hi >= mh ? hi - mh : hi - mh + mod;
+		}
+		
+	public:
+		explicit Montgomery(uint64_t modulus) : mod(modulus) {
+			if (mod < 3 || (mod & 1) == 0) throw std::invalid_argument("Montgomery modulus must be odd and greater than 1");
+			inv = mod;
+			for (int i = 0; i < 5; ++i) inv *= 2 - mod * inv;
+			r1 = (0 - mod) % mod;
+			r2 = r1;
+			for (int i = 0; i < 64; ++i) r2 = add(r2, r2);
+		}
+		
+		uint64_t modulus() const { return mod; }
+		uint64_t one() const { return r1; }
+		
+		uint64_t to(uint64_t x) const { return mul(x % mod, r2); }
+		uint64_t from(uint64_t x) const { return reduce(0, x); }
+		
+		uint64_t add(uint64_t a, uint64_t b) const {
+			uint64_t s = a + b;
+			return s < a || s >= mod ? s - mod : s;
+		}
+		
+		uint64_t sub(uint64_t a, uint64_t b) const {
+			return a >= b ? a - b : a - b + mod;
+		}
+		
+		uint64_t mul(uint64_t a, uint64_t b) const {
+			uint64_t hi, lo = extend::mul128(a, b, &hi);
+			return reduce(hi, lo);
+		}
+		
+		uint64_t pow(uint64_t base, uint64_t exp) const {
+			uint64_t res = r1;
+			while (exp > 0) {
+				if (exp & 1) res = mul(res, base);
+				base = mul(base, base);
+				exp >>= 1;
+			}
+			return res;
+		}
+	};
+	
 	template <typename T>
 	class Math {
 	public:
 		struct Point { T x, y; };
 		
 	private:
+		// Native multiply when the product fits in 64 bits, a 128-bit product for
+		// larger moduli, and the shift-and-add loop only as a portable fallback.
 		static T mul_mod(T a, T b, T mod) {
+			if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+				uint64_t m = static_cast<uint64_t>(mod);
+				uint64_t x = static_cast<uint64_t>(a % mod), y = static_cast<uint64_t>(b % mod);
+				if (sizeof(T) <= 4 || m <= UINT32_MAX) return static_cast<T>(x * y % m);
+#if defined(__SIZEOF_INT128__)
+				return static_cast<T>(static_cast<extend::uint128_t>(x) * y % m);
+#endif
+			}
 			T res = 0;
 			a %= mod;
 			while (b > 0) {
@@ -40,6 +116,174 @@ namespace STAR_CPP {
 			return res;
 		}
 		
+		// Strong probable-prime test of n = d * 2^s + 1 to base a.
+		static bool strong_witness(const Montgomery& mont, uint64_t d, int s, uint64_t a) {
+			uint64_t one = mont.one(), minus_one = mont.modulus() - one;
+			uint64_t x = mont.pow(mont.to(a), d);
+			if (x == one || x == minus_one) return true;
+			for (int r = 1; r < s; ++r) {
+				x = mont.mul(x, x);
+				if (x == minus_one) return true;
+			}
+			return false;
+		}
+		
+		static bool strong_witness(uint64_t n, uint64_t d, int s, uint64_t a) {
+			uint64_t x = 1, base = a % n;
+			for (uint64_t e = d; e > 0; e >>= 1) {
+				if (e & 1) x = x * base % n;
+				base = base * base % n;
+			}
+			if (x == 1 || x == n - 1) return true;
+			for (int r = 1; r < s; ++r) {
+				x = x * x % n;
+				if (x == n - 1) return true;
+			}
+			return false;
+		}
+		
+		// Brent's variant of Pollard's rho on an odd composite n, with the gcd taken
+		// once per 128 steps over the product of differences.
+		static uint64_t pollard_rho(uint64_t n) {
+			Montgomery mont(n);
+			const uint64_t block = 128;
+			for (uint64_t seed = 1;; ++seed) {
+				uint64_t c = mont.to(seed), y = mont.to(seed + 1), x = y, ys = y, q = mont.one(), g = 1;
+				auto f = [&](uint64_t v) { return mont.add(mont.mul(v, v), c); };
+				for (uint64_t r = 1; g == 1; r <<= 1) {
+					x = y;
+					for (uint64_t i = 0; i < r; ++i) y = f(y);
+					for (uint64_t k = 0; k < r && g == 1; k += block) {
+						ys = y;
+						for (uint64_t i = 0; i < block && i < r - k; ++i) {
+							y = f(y);
+							q = mont.mul(q, x > y ? x - y : y - x);
+						}
+						g = std::gcd(q, n);
+					}
+				}
+				if (g == n) {
+					do {
+						ys = f(ys);
+						g = std::gcd(x > ys ? x - ys : ys - x, n);
+					} while (g == 1);
+				}
+				if (g != n) return g;
+			}
+		}
+		
+		static void factor_rec(uint64_t n, std::vector<long long>& factors) {
+			if (n == 1) return;
+			if (is_prime(static_cast<long long>(n))) {
+				factors.push_back(static_cast<long long>(n));
+				return;
+			}
+			uint64_t d = pollard_rho(n);
+			factor_rec(d, factors);
+			factor_rec(n / d, factors);
+		}
+		
+		// Odd numbers per sieve segment: L1-sized while most sieving primes hit it many
+		// times, growing towards L2 once sqrt(hi) passes 2^17. Segments are first
+		// stamped with a pattern that already removes multiples of 3, 5, 7, 11 and 13.
+		static constexpr uint64_t SIEVE_MIN_SEGMENT = 1 << 15, SIEVE_MAX_SEGMENT = 1 << 18;
+		static constexpr uint64_t PRESIEVE = 3 * 5 * 7 * 11 * 13;
+		
+		static const std::vector<uint8_t>& presieve_pattern() {
+			static const std::vector<uint8_t> pattern = [] {
+				std::vector<uint8_t> flags(PRESIEVE, 1);
+				for (uint64_t q : { 3, 5, 7, 11, 13 }) {
+					for (uint64_t i = q / 2; i < PRESIEVE; i += q) flags[i] = 0;
+				}
+				return flags;
+			}();
+			return pattern;
+		}
+		
+		static uint64_t isqrt(uint64_t n) {
+			uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+			while (r * r > n) --r;
+			while ((r + 1) * (r + 1) <= n) ++r;
+			return r;
+		}
+		
+		// Odd primes in [17, sqrt(hi)], the ones not covered by the presieve pattern.
+		static std::vector<uint32_t> sieving_primes(uint64_t hi) {
+			uint64_t limit = isqrt(hi);
+			std::vector<uint8_t> composite(limit / 2 + 1);
+			std::vector<uint32_t> primes;
+			for (uint64_t i = 3; i <= limit; i += 2) {
+				if (composite[i / 2]) continue;
+				if (i > 13) primes.push_back(static_cast<uint32_t>(i));
+				for (uint64_t j = i * i; j <= limit; j += 2 * i) composite[j / 2] = 1;
+			}
+			return primes;
+		}
+		
+		static uint64_t sieve_segment(const std::vector<uint32_t>& primes) {
+			if (primes.empty()) return SIEVE_MIN_SEGMENT;
+			return std::clamp<uint64_t>(std::bit_ceil(uint64_t(primes.back())) / 4, SIEVE_MIN_SEGMENT, SIEVE_MAX_SEGMENT);
+		}
+		
+		// Sieves the odd numbers of [first, hi] (first odd) segment by segment and
+		// calls on_segment(flags, base, count): flags[i] != 0 iff base + 2i is prime.
+		template <typename F>
+		static void sieve_odd(uint64_t first, uint64_t hi, const std::vector<uint32_t>& primes, F&& on_segment) {
+			const std::vector<uint8_t>& pattern = presieve_pattern();
+			const uint64_t segment = sieve_segment(primes);
+			std::vector<uint8_t> flags(segment);
+			std::vector<uint64_t> next(primes.size());
+			size_t active = 0;
+			for (uint64_t base = first; base <= hi; base += 2 * segment) {
+				uint64_t count = std::min(segment, (hi - base) / 2 + 1), last = base + 2 * (count - 1);
+				for (uint64_t i = 0, offset = base / 2 % PRESIEVE; i < count; offset = 0) {
+					uint64_t len = std::min(count - i, PRESIEVE - offset);
+					std::memcpy(flags.data() + i, pattern.data() + offset, len);
+					i += len;
+				}
+				// Offsets are kept relative to the current segment, so no division per segment.
+				for (; active < primes.size() && uint64_t(primes[active]) * primes[active] <= last; ++active) {
+					uint64_t p = primes[active], m = std::max(p * p, (base + p - 1) / p * p);
+					if ((m & 1) == 0) m += p;
+					next[active] = (m - base) / 2;
+				}
+				for (size_t j = 0; j < active; ++j) {
+					uint64_t p = primes[j], i = next[j];
+					for (; i < count; i += p) flags[i] = 0;
+					next[j] = i - count;
+				}
+				if (base <= 13) {
+					for (uint64_t q : { 3, 5, 7, 11, 13 }) {
+						if (q >= base && q <= last) flags[(q - base) / 2] = 1;
+					}
+					if (base == 1) flags[0] = 0;
+				}
+				on_segment(flags.data(), base, count);
+			}
+		}
+		
+		// Splits the odd numbers of [lo, hi] into segment-aligned chunks handed out to
+		// worker threads; prepare(chunks) runs first, then body(chunk, flags, base, count).
+		template <typename Prepare, typename Body>
+		static void sieve_parallel(long long lo, long long hi, unsigned threads, Prepare&& prepare, Body&& body) {
+			uint64_t first = static_cast<uint64_t>(std::max(lo, 3LL)) | 1, last = static_cast<uint64_t>(hi);
+			if (first > last) return;
+			if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+			std::vector<uint32_t> primes = sieving_primes(last);
+			uint64_t odds = (last - first) / 2 + 1, segment = sieve_segment(primes);
+			uint64_t chunk = (odds + 8 * threads - 1) / (8 * threads);
+			chunk = std::max<uint64_t>(1, (chunk + segment - 1) / segment) * segment;
+			uint64_t chunks = (odds + chunk - 1) / chunk;
+			prepare(static_cast<size_t>(chunks));
+			
+			parallel_for(chunks, threads, [&](uint64_t c) {
+				uint64_t from = first + 2 * c * chunk, to = std::min(last, from + 2 * (chunk - 1));
+				sieve_odd(from, to, primes, [&](const uint8_t* flags, uint64_t base, uint64_t count) {
+					body(static_cast<size_t>(c), flags, base, count);
+				});
+			});
+		}
+		
 	public:
 		static T dist_sq(const Point& a, const Point& b) {
 			T dx = a.x - b.x;
@@ -121,6 +365,14 @@ namespace STAR_CPP {
 		}
 		
 		static T qpow_mod(T base, T exp, T mod) {
+			if constexpr (std::is_integral_v<T> && sizeof(T) == 8) {
+				uint64_t m = static_cast<uint64_t>(mod);
+				if (m > UINT32_MAX && (m & 1) && exp > 0) {
+					Montgomery mont(m);
+					uint64_t x = static_cast<uint64_t>(base % mod);
+					return static_cast<T>(mont.from(mont.pow(mont.to(x), static_cast<uint64_t>(exp))));
+				}
+			}
 			T res = 1 % mod;
 			base %= mod;
 			while (exp > 0) {
@@ -189,45 +441,109 @@ namespace STAR_CPP {
 		static T C_mod_direct(int n, int m, T mod) {
 			if (m < 0 || m > n) return 0;
 			m = m < n - m ? m : n - m;
-			T res = 1;
+			T numerator = 1 % mod, denominator = 1 % mod;
 			for (int i = 1; i <= m; ++i) {
-				T numerator = (n - m + i) % mod;
-				T denominator = inv_mod((T)i, mod);
-				res = mul_mod(res, numerator, mod);
-				res = mul_mod(res, denominator, mod);
+				numerator = mul_mod(numerator, (T)((n - m + i) % mod), mod);
+				denominator = mul_mod(denominator, (T)(i % mod), mod);
 			}
-			return res;
+			return mul_mod(numerator, inv_mod(denominator, mod), mod);
 		}
 		
 		static bool is_prime(long long n) {
 			if (n < 2) return false;
 			if (n == 2 || n == 3) return true;
 			if (n % 2 == 0) return false;
-			long long d = n - 1;
+			uint64_t d = n - 1;
 			int s = 0;
 			while ((d & 1) == 0) {
 				d >>= 1;
 				s++;
 			}
-			static const std::vector<int> bases = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
-			for (int a : bases) {
-				if (n == a) return true;
-				if (n % a == 0) return false;
-				long long x = qpow_mod((long long)a, d, (long long)n);
-				if (x == 1 || x == n - 1) continue;
-				bool composite = true;
-				for (int r = 1; r < s; ++r) {
-					x = mul_mod(x, x, (long long)n);
-					if (x == n - 1) {
-						composite = false;
-						break;
-					}
+			static const int small_primes[] = { 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+			for (int p : small_primes) {
+				if (n == p) return true;
+				if (n % p == 0) return false;
+			}
+			if (n < 41 * 41) return true;
+			// Deterministic base sets: {2, 7, 61} below 2^32, Jim Sinclair's 7 bases above.
+			uint64_t u = static_cast<uint64_t>(n);
+			if (u <= UINT32_MAX) {
+				for (uint64_t a : { 2, 7, 61 }) {
+					if (a % u != 0 && !strong_witness(u, d, s, a)) return false;
 				}
-				if (composite) return false;
+				return true;
+			}
+			Montgomery mont(u);
+			for (uint64_t a : { 2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL }) {
+				if (!strong_witness(mont, d, s, a)) return false;
 			}
 			return true;
 		}
 		
+		// Prime factors of n in non-decreasing order, with multiplicity.
+		static std::vector<long long> factorize(long long n) {
+			std::vector<long long> factors;
+			if (n < 2) return factors;
+			for (long long p : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 }) {
+				while (n % p == 0) {
+					factors.push_back(p);
+					n /= p;
+				}
+			}
+			if (n > 1) factor_rec(static_cast<uint64_t>(n), factors);
+			std::sort(factors.begin(), factors.end());
+			return factors;
+		}
+		
+		static std::vector<long long> divisors(long long n) {
+			std::vector<long long> result;
+			if (n < 1) return result;
+			result.push_back(1);
+			std::vector<long long> factors = factorize(n);
+			for (size_t i = 0; i < factors.size();) {
+				size_t j = i, count = result.size();
+				long long power = 1;
+				while (j < factors.size() && factors[j] == factors[i]) {
+					power *= factors[j++];
+					for (size_t k = 0; k < count; ++k) result.push_back(result[k] * power);
+				}
+				i = j;
+			}
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+		
+		// Uniform prime in [lo, hi] drawn with rng.randint; throws if there is none.
+		// Wide ranges use rejection, narrow ones enumerate their primes.
+		template <typename Rng>
+		static long long random_prime(Rng& rng, long long lo, long long hi) {
+			lo = std::max(lo, 2LL);
+			if (lo > hi) throw std::invalid_argument("No primes in the given range");
+			if (static_cast<uint64_t>(hi - lo) >= (1 << 16)) {
+				while (true) {
+					long long x = rng.randint(lo, hi);
+					if (is_prime(x)) return x;
+				}
+			}
+			std::vector<long long> primes;
+			for (long long x = lo; x <= hi; ++x) {
+				if (is_prime(x)) primes.push_back(x);
+			}
+			if (primes.empty()) throw std::invalid_argument("No primes in the given range");
+			return primes[rng.randint(0, static_cast<int>(primes.size()) - 1)];
+		}
+		
+		// p * q with exactly `bits` bits (4 <= bits <= 62), p having bits / 2 bits.
+		template <typename Rng>
+		static long long random_semiprime(Rng& rng, int bits) {
+			if (bits < 4 || bits > 62) throw std::invalid_argument("Semiprime bit length must be in [4, 62]");
+			int half = bits / 2;
+			long long p = random_prime(rng, 1LL << (half - 1), (1LL << half) - 1);
+			long long low = 1LL << (bits - 1), high = (1LL << bits) - 1;
+			long long q = random_prime(rng, (low + p - 1) / p, high / p);
+			return p * q;
+		}
+		
 		static long long next_prime(long long n) {
 			if (n < 2) return 2;
 			long long res = (n % 2 == 0) ? n + 1 : n + 2;
@@ -238,18 +554,276 @@ namespace STAR_CPP {
 		}
 		
 		static std::vector<int> sieve_primes(int n) {
-			std::vector<bool> is_composite(n + 1, false);
 			std::vector<int> primes;
-			for (int i = 2; i <= n; ++i) {
-				if (!is_composite[i]) primes.push_back(i);
-				for (int p : primes) {
-					if ((long long)i * p > n) break;
-					is_composite[i * p] = true;
-					if (i % p == 0) break;
+			for_each_prime(2, n, [&](long long p) { primes.push_back(static_cast<int>(p)); });
+			return primes;
+		}
+		
+		// Calls f(p) for every prime p in [lo, hi] in increasing order, without storing them.
+		template <typename F>
+		static void for_each_prime(long long lo, long long hi, F&& f) {
+			if (hi < 2 || lo > hi) return;
+			if (lo <= 2) f(2LL);
+			uint64_t first = static_cast<uint64_t>(std::max(lo, 3LL)) | 1;
+			if (first > static_cast<uint64_t>(hi)) return;
+			sieve_odd(first, hi, sieving_primes(hi), [&](const uint8_t* flags, uint64_t base, uint64_t count) {
+				for (uint64_t i = 0; i < count; ++i) {
+					if (flags[i]) f(static_cast<long long>(base + 2 * i));
 				}
-			}
+			});
+		}
+		
+		// Primes in [lo, hi], sorted; segments are split across `threads` workers
+		// (0 = hardware concurrency).
+		static std::vector<long long> primes_in(long long lo, long long hi, unsigned threads = 0) {
+			std::vector<long long> primes;
+			if (hi < 2 || lo > hi) return primes;
+			if (lo <= 2) primes.push_back(2);
+			std::vector<std::vector<long long>> parts;
+			sieve_parallel(lo, hi, threads, [&](size_t chunks) { parts.resize(chunks); },
+				[&](size_t chunk, const uint8_t* flags, uint64_t base, uint64_t count) {
+					for (uint64_t i = 0; i < count; ++i) {
+						if (flags[i]) parts[chunk].push_back(static_cast<long long>(base + 2 * i));
+					}
+				});
+			for (const auto& part : parts) primes.insert(primes.end(), part.begin(), part.end());
 			return primes;
 		}
+		
+		static long long count_primes(long long lo, long long hi, unsigned threads = 0) {
+			if (hi < 2 || lo > hi) return 0;
+			std::atomic<long long> total(lo <= 2 ? 1 : 0);
+			sieve_parallel(lo, hi, threads, [](size_t) {},
+				[&](size_t, const uint8_t* flags, uint64_t, uint64_t count) {
+					long long c = 0;
+					for (uint64_t i = 0; i < count; ++i) c += flags[i];
+					total += c;
+				});
+			return total;
+		}
+	};
+	
+	// One linear-sieve pass over [0, n] filling the requested subset of tables. A
+	// composite's smallest prime factor is at most sqrt(n) < 2^16, so it is kept in
+	// 16 bits with 0 marking primes; d(n) < 2^16 likewise for n < 2^32.
+	class LinearSieve {
+	public:
+		enum Table : unsigned { SPF = 1, PHI = 2, MU = 4, DIVISOR_COUNT = 8, DIVISOR_SUM = 16, ALL = 31 };
+		
+	private:
+		uint32_t n;
+		unsigned tables;
+		std::vector<uint32_t> prime_list;
+		std::vector<uint16_t> spf_table;
+		std::vector<uint32_t> phi_table;
+		std::vector<int8_t> mu_table;
+		std::vector<uint16_t> d_table;
+		std::vector<uint64_t> sigma_table;
+		
+	public:
+		explicit LinearSieve(uint32_t n, unsigned tables = SPF) : n(n), tables(tables) {
+			const bool phi = tables & PHI, mu = tables & MU, d = tables & DIVISOR_COUNT, sigma = tables & DIVISOR_SUM;
+			spf_table.assign(size_t(n) + 1, 0);
+			if (phi) phi_table.assign(size_t(n) + 1, 0);
+			if (mu) mu_table.assign(size_t(n) + 1, 0);
+			if (d) d_table.assign(size_t(n) + 1, 0);
+			if (sigma) sigma_table.assign(size_t(n) + 1, 0);
+			if (n >= 1) {
+				if (phi) phi_table[1] = 1;
+				if (mu) mu_table[1] = 1;
+				if (d) d_table[1] = 1;
+				if (sigma) sigma_table[1] = 1;
+			}
+			if (n >= 16) prime_list.reserve(static_cast<size_t>(1.2 * n / std::log(double(n))));
+			
+			for (uint64_t i = 2; i <= n; ++i) {
+				if (spf_table[i] == 0) {
+					prime_list.push_back(static_cast<uint32_t>(i));
+					if (phi) phi_table[i] = static_cast<uint32_t>(i - 1);
+					if (mu) mu_table[i] = -1;
+					if (d) d_table[i] = 2;
+					if (sigma) sigma_table[i] = i + 1;
+				}
+				uint64_t lp = spf_table[i] ? spf_table[i] : i;
+				for (uint32_t p : prime_list) {
+					uint64_t x = i * p;
+					if (p > lp || x > n) break;
+					spf_table[x] = static_cast<uint16_t>(p);
+					if (p == lp) {
+						// p already divides i: phi gains a full factor p, mu vanishes, and
+						// d(ip) = 2 d(i) - d(i/p), sigma(ip) = (p+1) sigma(i) - p sigma(i/p).
+						if (phi) phi_table[x] = phi_table[i] * p;
+						if (d) d_table[x] = static_cast<uint16_t>(2 * d_table[i] - d_table[i / p]);
+						if (sigma) sigma_table[x] = (p + 1) * sigma_table[i] - p * sigma_table[i / p];
+						break;
+					}
+					if (phi) phi_table[x] = phi_table[i] * (p - 1);
+					if (mu) mu_table[x] = static_cast<int8_t>(-mu_table[i]);
+					if (d) d_table[x] = static_cast<uint16_t>(2 * d_table[i]);
+					if (sigma) sigma_table[x] = sigma_table[i] * (p + 1);
+				}
+			}
+			if (!(tables & SPF)) std::vector<uint16_t>().swap(spf_table);
+		}
+		
+		uint32_t limit() const { return n; }
+		const std::vector<uint32_t>& primes() const { return prime_list; }
+		
+		// Table lookups for 1 <= x <= n; each needs its table requested at construction.
+		uint32_t spf(uint32_t x) const { return spf_table[x] ? spf_table[x] : x; }
+		bool is_prime(uint32_t x) const { return x >= 2 && spf_table[x] == 0; }
+		uint32_t phi(uint32_t x) const { return phi_table[x]; }
+		int mu(uint32_t x) const { return mu_table[x]; }
+		uint32_t divisor_count(uint32_t x) const { return d_table[x]; }
+		uint64_t divisor_sum(uint32_t x) const { return sigma_table[x]; }
+		
+		// (prime, exponent) pairs of x in increasing order, O(log x) via the spf table.
+		std::vector<std::pair<uint32_t, int>> factorize(uint32_t x) const {
+			if (!(tables & SPF)) throw std::logic_error("LinearSieve was built without the SPF table");
+			if (x == 0 || x > n) throw std::out_of_range("Value outside the sieved range");
+			std::vector<std::pair<uint32_t, int>> factors;
+			while (x > 1) {
+				uint32_t p = spf(x);
+				int e = 0;
+				for (; x % p == 0; x /= p) ++e;
+				factors.emplace_back(p, e);
+			}
+			return factors;
+		}
+	};
+	
+	// Factorials, inverse factorials and inverses of 1..n modulo an odd prime
+	// mod > n, kept in Montgomery form so C, P and Catalan cost three reductions.
+	// Lookups past n throw std::out_of_range.
+	// Tables that fit in cache build inv[] with inv[i] = -(mod / i) * inv[mod % i];
+	// larger ones use chunked prefix products (optionally threaded), since the
+	// recurrence's divisions and scattered inv[mod % i] reads dominate there.
+	template <typename T>
+	class BinomialTable {
+	private:
+		static_assert(std::is_integral_v<T>, "BinomialTable requires an integral type");
+		
+		int n;
+		Montgomery mont;
+		std::vector<T> fact, inv_fact, inv;
+		
+		void build_sequential() {
+			const uint64_t p = mont.modulus(), one = mont.one();
+			fact[0] = inv_fact[0] = static_cast<T>(one);
+			if (n >= 1) fact[1] = inv_fact[1] = inv[1] = static_cast<T>(one);
+			uint64_t x = one;
+			for (int i = 2; i <= n; ++i) {
+				x = mont.add(x, one);
+				fact[i] = static_cast<T>(mont.mul(fact[i - 1], x));
+				inv[i] = static_cast<T>(mont.mul(mont.to(p - p / i), inv[p % i]));
+				inv_fact[i] = static_cast<T>(mont.mul(inv_fact[i - 1], inv[i]));
+			}
+		}
+		
+		// fact[] as chunked prefix products; inv_fact[] walks each chunk downwards from
+		// 1 / n! (one exponentiation), and inv[i] = fact[i - 1] * inv_fact[i].
+		void build_parallel(unsigned threads) {
+			const uint64_t one = mont.one();
+			const uint64_t size = static_cast<uint64_t>(n) + 1;
+			const uint64_t chunk = std::max<uint64_t>(1 << 16, (size + 4 * threads - 1) / (4 * threads));
+			const uint64_t chunks = (size + chunk - 1) / chunk;
+			std::vector<uint64_t> prefix(chunks);
+			
+			parallel_for(chunks, threads, [&](uint64_t c) {
+				uint64_t lo = c * chunk, hi = std::min(size, lo + chunk);
+				uint64_t x = mont.to(lo == 0 ? 1 : lo), acc = one;
+				for (uint64_t i = lo; i < hi; ++i) {
+					if (i > 0) acc = mont.mul(acc, x);
+					fact[i] = static_cast<T>(acc);
+					if (i > 0) x = mont.add(x, one);
+				}
+				prefix[c] = acc;
+			});
+			
+			// For chunk c = [lo, hi): before[c] = (lo - 1)! and after[c] = 1 / (hi - 1)!.
+			std::vector<uint64_t> before(chunks, one), after(chunks, one);
+			for (uint64_t c = 1; c < chunks; ++c) before[c] = mont.mul(before[c - 1], prefix[c - 1]);
+			uint64_t top = mont.pow(mont.mul(before[chunks - 1], prefix[chunks - 1]), mont.modulus() - 2);
+			after[chunks - 1] = top;
+			for (uint64_t c = chunks - 1; c > 0; --c) after[c - 1] = mont.mul(after[c], prefix[c]);
+			
+			parallel_for(chunks, threads, [&](uint64_t c) {
+				uint64_t lo = c * chunk, hi = std::min(size, lo + chunk);
+				if (c > 0) {
+					for (uint64_t i = lo; i < hi; ++i) fact[i] = static_cast<T>(mont.mul(before[c], fact[i]));
+				}
+				uint64_t acc = after[c], x = mont.to(hi - 1);
+				for (uint64_t i = hi; i-- > lo;) {
+					inv_fact[i] = static_cast<T>(acc);
+					if (i > 0) inv[i] = static_cast<T>(mont.mul(i == lo ? before[c] : fact[i - 1], acc));
+					acc = mont.mul(acc, x);
+					x = mont.sub(x, one);
+				}
+			});
+		}
+		
+		uint64_t value(uint64_t x) const { return mont.from(x); }
+		
+		static uint64_t prime_modulus(T mod) {
+			if (mod < 3 || !Math<long long>::is_prime(static_cast<long long>(mod))) throw std::invalid_argument("Modulus must be an odd prime");
+			return static_cast<uint64_t>(mod);
+		}
+		
+		void check(int i) const {
+			if (i < 0 || i > n) throw std::out_of_range("Index outside the table range");
+		}
+		
+	public:
+		// threads = 0 uses hardware concurrency; small tables always build on one thread.
+		BinomialTable(int n, T mod, unsigned threads = 1) : n(n), mont(prime_modulus(mod)) {
+			if (n < 0) throw std::invalid_argument("Table size cannot be negative");
+			if (static_cast<uint64_t>(n) >= static_cast<uint64_t>(mod)) throw std::invalid_argument("Modulus must be a prime larger than the table size");
+			fact.resize(size_t(n) + 1);
+			inv_fact.resize(size_t(n) + 1);
+			inv.resize(size_t(n) + 1);
+			if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+			if (n < (1 << 18)) build_sequential();
+			else build_parallel(threads);
+		}
+		
+		int limit() const { return n; }
+		T modulus() const { return static_cast<T>(mont.modulus()); }
+		
+		T factorial(int i) const {
+			check(i);
+			return static_cast<T>(value(fact[i]));
+		}
+		
+		T inverse_factorial(int i) const {
+			check(i);
+			return static_cast<T>(value(inv_fact[i]));
+		}
+		
+		T inverse(int i) const {
+			check(i);
+			if (i == 0) throw std::invalid_argument("Zero has no inverse");
+			return static_cast<T>(value(inv[i]));
+		}
+		
+		T C(int a, int b) const {
+			if (b < 0 || b > a) return 0;
+			check(a);
+			return static_cast<T>(value(mont.mul(mont.mul(fact[a], inv_fact[b]), inv_fact[a - b])));
+		}
+		
+		T P(int a, int b) const {
+			if (b < 0 || b > a) return 0;
+			check(a);
+			return static_cast<T>(value(mont.mul(fact[a], inv_fact[a - b])));
+		}
+		
+		// Needs 2 * k <= limit().
+		T catalan(int k) const {
+			if (k < 0) return 0;
+			if (k > n / 2) throw std::out_of_range("Index outside the table range");
+			if (k == 0) return static_cast<T>(value(mont.one()));
+			return static_cast<T>(value(mont.mul(mont.mul(fact[2 * k], inv_fact[k]), inv_fact[k + 1])));
+		}
 	};
 	
 }
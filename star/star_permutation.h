@@ -0,0 +1,281 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+#ifndef STAR_PERMUTATION_H
+#define STAR_PERMUTATION_H
+
+#include<cstdint>
+#include<cstddef>
+#include<iterator>
+#include<utility>
+#include<ranges>
+#include<vector>
+#include<algorithm>
+#include<memory>
+#include "extend/StarExtendedRandomEngine.h"
+#include "star_distribution.h"
+#include "utils/StarParallel.h"
+
+namespace STAR_CPP {
+
+	// Keyed pseudo-random bijection of [0, n) with O(1) memory. An unbalanced Feistel
+	// network permutes the smallest power-of-two domain covering n (at most 2n), and
+	// cycle-walking maps values that land outside [0, n) back in, so perm[i] and
+	// inverse(y) take fewer than two network passes on average. Small domains, where
+	// Feistel networks are measurably non-uniform, use an explicit shuffled table.
+	class FeistelPermutation : public std::ranges::view_interface<FeistelPermutation> {
+	private:
+		static constexpr int ROUNDS = 6;
+		static constexpr uint64_t TABLE_LIMIT = 4096;
+
+		uint64_t n = 0;
+		unsigned left_bits = 0, right_bits = 0;
+		uint64_t keys[ROUNDS] = {};
+		std::vector<uint32_t> forward, backward;
+
+		static uint64_t mask(unsigned bits) { return bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1; }
+
+		uint64_t encrypt(uint64_t x) const {
+			unsigned lb = left_bits, rb = right_bits;
+			uint64_t l = x >> rb, r = x & mask(rb);
+			for (int k = 0; k < ROUNDS; ++k) {
+				uint64_t next = l ^ (extend::mix64(r ^ keys[k]) & mask(lb));
+				l = r;
+				r = next;
+				std::swap(lb, rb);
+			}
+			return (l << rb) | r;
+		}
+
+		uint64_t decrypt(uint64_t x) const {
+			// ROUNDS is even, so the layout after encryption matches the input layout.
+			unsigned lb = left_bits, rb = right_bits;
+			uint64_t l = x >> rb, r = x & mask(rb);
+			for (int k = ROUNDS - 1; k >= 0; --k) {
+				std::swap(lb, rb);
+				uint64_t prev = r ^ (extend::mix64(l ^ keys[k]) & mask(lb));
+				r = l;
+				l = prev;
+			}
+			return (l << rb) | r;
+		}
+
+	public:
+		class iterator {
+		private:
+			const FeistelPermutation* perm = nullptr;
+			uint64_t index = 0;
+
+		public:
+			using value_type = uint64_t;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
+
+			iterator() = default;
+			iterator(const FeistelPermutation* perm, uint64_t index) : perm(perm), index(index) {}
+
+			uint64_t operator*() const { return (*perm)[index]; }
+			iterator& operator++() { ++index; return *this; }
+			iterator operator++(int) { iterator old = *this; ++index; return old; }
+			bool operator==(const iterator& other) const { return index == other.index; }
+		};
+
+		FeistelPermutation() = default;
+
+		FeistelPermutation(uint64_t n, uint64_t seed) : n(n) {
+			unsigned bits = 0;
+			while (bits < 64 && (uint64_t(1) << bits) < n) ++bits;
+			right_bits = bits / 2;
+			left_bits = bits - right_bits;
+			for (int k = 0; k < ROUNDS; ++k) keys[k] = extend::mix64(seed + (k + 1) * 0x9e3779b97f4a7c15ULL);
+
+			if (n <= TABLE_LIMIT) {
+				extend::SplitMix64Rand gen(seed);
+				forward.resize(n);
+				backward.resize(n);
+				for (uint32_t i = 0; i < n; ++i) forward[i] = i;
+				for (uint32_t i = uint32_t(n); i > 1; --i) std::swap(forward[i - 1], forward[UniformInt<uint32_t>(0, i - 1)(gen)]);
+				for (uint32_t i = 0; i < n; ++i) backward[forward[i]] = i;
+			}
+		}
+
+		uint64_t size() const { return n; }
+
+		uint64_t operator[](uint64_t i) const {
+			if (!forward.empty()) return forward[i];
+			uint64_t x = encrypt(i);
+			while (x >= n) x = encrypt(x);
+			return x;
+		}
+
+		uint64_t inverse(uint64_t y) const {
+			if (!backward.empty()) return backward[y];
+			uint64_t x = decrypt(y);
+			while (x >= n) x = decrypt(x);
+			return x;
+		}
+
+		iterator begin() const { return iterator(this, 0); }
+		iterator end() const { return iterator(this, n); }
+	};
+
+	// Draws one index in [0, range - t) for each t < k, k chosen so that the product of
+	// the ranges fits in 64 bits (Brackett-Rozinsky and Lemire): one word yields all k
+	// by repeated multiply-high, with a single unbiased rejection check on the leftover.
+	template <typename Engine>
+	unsigned bounded_batch(Engine& engine, uint64_t range, uint64_t* index) {
+		unsigned k = range > (uint64_t(1) << 30) ? 1 : range > (1u << 19) ? 2 : range > (1u << 14) ? 3 : range > (1u << 11) ? 4 : range > (1u << 9) ? 5 : 6;
+		if (k > range - 1) k = unsigned(range - 1);
+
+		uint64_t bound = 1;
+		for (unsigned t = 0; t < k; ++t) bound *= range - t;
+
+		auto draw = [&]() {
+			uint64_t x = RandomBits<Engine>::next64(engine);
+			for (unsigned t = 0; t < k; ++t) x = extend::mul128(x, range - t, &index[t]);
+			return x;
+		};
+		uint64_t leftover = draw();
+		if (leftover < bound) {
+			uint64_t threshold = (0 - bound) % bound;
+			while (leftover < threshold) leftover = draw();
+		}
+		return k;
+	}
+
+	// Fisher-Yates on batched bounded draws. For arrays past cache size the indices
+	// are drawn a few swaps ahead and prefetched, since they do not depend on the
+	// array contents; this overlaps the cache misses.
+	template <typename It, typename Engine>
+	void batched_shuffle(It first, It last, Engine& engine) {
+		uint64_t i = static_cast<uint64_t>(last - first);
+		uint64_t index[6];
+
+		if (i <= (uint64_t(1) << 16)) {
+			while (i > 1) {
+				unsigned k = bounded_batch(engine, i, index);
+				for (unsigned t = 0; t < k; ++t) std::swap(first[i - 1 - t], first[index[t]]);
+				i -= k;
+			}
+			return;
+		}
+
+		constexpr unsigned AHEAD = 16;
+		uint64_t ring[AHEAD];
+		unsigned head = 0, queued = 0;
+		uint64_t next = i;
+		auto refill = [&]() {
+			while (queued + 6 <= AHEAD && next > 1) {
+				unsigned k = bounded_batch(engine, next, index);
+				for (unsigned t = 0; t < k; ++t) {
+#if defined(__GNUC__)
+					__builtin_prefetch(std::addressof(first[index[t]]), 1);
+#endif
+					ring[(head + queued++) % AHEAD] = index[t];
+				}
+				next -= k;
+			}
+		};
+
+		refill();
+		while (queued > 0) {
+			std::swap(first[i - 1], first[ring[head]]);
+			head = (head + 1) % AHEAD;
+			--queued;
+			--i;
+			refill();
+		}
+	}
+
+	// Uniformly interleaves two adjacent shuffled runs [first, mid) and [mid, last)
+	// in place (the merge step of Bacher et al.'s MergeShuffle).
+	template <typename It, typename Engine>
+	void merge_shuffled(It first, It mid, It last, Engine& engine) {
+		uint64_t i = 0, j = static_cast<uint64_t>(mid - first), n = static_cast<uint64_t>(last - first);
+		uint64_t bits = 0;
+		int left = 0;
+		// Branch-free while both runs are non-empty; the coin only picks which element moves.
+		while (i < j && j < n) {
+			if (left == 0) {
+				bits = RandomBits<Engine>::next64(engine);
+				left = 64;
+			}
+			uint64_t take_right = bits & 1;
+			bits >>= 1;
+			--left;
+			auto x = std::move(first[i]), y = std::move(first[j]);
+			first[i] = take_right ? std::move(y) : std::move(x);
+			first[j] = take_right ? std::move(x) : std::move(y);
+			j += take_right;
+			++i;
+		}
+		while (true) {
+			if (left == 0) {
+				bits = RandomBits<Engine>::next64(engine);
+				left = 64;
+			}
+			bool take_right = bits & 1;
+			bits >>= 1;
+			--left;
+			if (take_right) {
+				if (j == n) break;
+				std::swap(first[i], first[j]);
+				++j;
+			} else if (i == j) {
+				break;
+			}
+			++i;
+		}
+		for (; i < n; ++i) std::swap(first[i], first[UniformInt<uint64_t>(0, i)(engine)]);
+	}
+
+	// Parallel MergeShuffle: cache-sized blocks are shuffled independently, then merged
+	// pairwise level by level. Task t draws from base.stream(t), so the result depends
+	// only on the base engine, not on the number of threads. Pass a split() child as
+	// base, not an engine whose own later draws matter.
+	template <typename It, typename Engine>
+	void merge_shuffle(It first, It last, const Engine& base, unsigned threads = 0) {
+		using T = typename std::iterator_traits<It>::value_type;
+		const uint64_t n = static_cast<uint64_t>(last - first);
+		const uint64_t block = std::max<uint64_t>(1024, (uint64_t(1) << 20) / sizeof(T));
+
+		uint64_t task_base = 0;
+		auto run = [&](uint64_t tasks, auto&& body) {
+			parallel_for(tasks, threads, [&](uint64_t t) {
+				Engine engine = base.stream(task_base + t);
+				body(t, engine);
+			});
+			task_base += tasks;
+		};
+
+		uint64_t blocks = (n + block - 1) / block;
+		run(blocks, [&](uint64_t b, Engine& engine) {
+			batched_shuffle(first + b * block, first + std::min(n, (b + 1) * block), engine);
+		});
+
+		for (uint64_t width = block; width < n; width *= 2) {
+			uint64_t pairs = (n + 2 * width - 1) / (2 * width);
+			run(pairs, [&](uint64_t p, Engine& engine) {
+				uint64_t lo = p * 2 * width, mid = std::min(n, lo + width), hi = std::min(n, lo + 2 * width);
+				if (mid < hi) merge_shuffled(first + lo, first + mid, first + hi, engine);
+			});
+		}
+	}
+
+}
+
+#endif
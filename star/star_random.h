@@ -20,54 +20,412 @@ TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
 
 #include<mutex>
 #include<random>
+#include<span>
+#include<vector>
+#include<type_traits>
 #include<stdexcept>
 #include<algorithm>
+#include<cmath>
+#include<cstring>
+#include<iterator>
+#include<unordered_map>
+#include<unordered_set>
+#include<string>
+#include<string_view>
 #include "extend/StarExtendedRandomEngine.h"
+#include "star_distribution.h"
+#include "star_permutation.h"
 
 namespace STAR_CPP {
 	
-	template <typename Engine>
+	struct NullMutex {
+		void lock() noexcept {}
+		void unlock() noexcept {}
+		bool try_lock() noexcept { return true; }
+	};
+	
+	template <typename Engine, typename Lock = std::mutex>
 	class Random {
 	private:
 		Engine engine;
-		mutable std::mutex mtx;
+		mutable Lock mtx;
 		
 		static const std::string CHARSET_ALPHA;
 		static const std::string CHARSET_NUMERIC;
 		static const std::string CHARSET_HEX;
 		static const std::string CHARSET_ALPHANUMERIC;
 		
+		template<typename It>
+		void shuffle_range(It first, It last) {
+			batched_shuffle(first, last, engine);
+		}
+		
+		template<typename Index>
+		void dense_partial_shuffle(size_t n, std::vector<size_t>& result) {
+			std::vector<Index> index(n);
+			for (size_t i = 0; i < n; ++i) index[i] = Index(i);
+			for (size_t i = 0; i < result.size(); ++i) {
+				size_t j = UniformInt<size_t>(i, n - 1)(engine);
+				std::swap(index[i], index[j]);
+				result[i] = index[i];
+			}
+		}
+		
+		std::vector<size_t> partial_shuffle_indices(size_t n, size_t k) {
+			if (k > n) k = n;
+			std::vector<size_t> result(k);
+			if (k == 0) return result;
+			
+			if (k >= n / 64) {
+				if (n <= UINT32_MAX) dense_partial_shuffle<uint32_t>(n, result);
+				else dense_partial_shuffle<size_t>(n, result);
+				return result;
+			}
+			
+			std::unordered_map<size_t, size_t> moved;
+			moved.reserve(2 * k);
+			for (size_t i = 0; i < k; ++i) {
+				size_t j = UniformInt<size_t>(i, n - 1)(engine);
+				auto it_j = moved.find(j);
+				size_t at_j = it_j == moved.end() ? j : it_j->second;
+				auto it_i = moved.find(i);
+				size_t at_i = it_i == moved.end() ? i : it_i->second;
+				result[i] = at_j;
+				moved[j] = at_i;
+			}
+			return result;
+		}
+		
+		// Floyd's algorithm: k distinct values of [0, n) with n == 0 meaning 2^64.
+		std::vector<uint64_t> floyd_indices(uint64_t n, size_t k) {
+			std::vector<uint64_t> result;
+			result.reserve(k);
+			std::unordered_set<uint64_t> seen;
+			seen.reserve(2 * k);
+			for (uint64_t j = n - k; j != n; ++j) {
+				uint64_t t = UniformInt<uint64_t>(0, j)(engine);
+				uint64_t pick = seen.insert(t).second ? t : j;
+				if (pick == j) seen.insert(j);
+				result.push_back(pick);
+			}
+			return result;
+		}
+		
+		double open01() {
+			return (double(RandomBits<Engine>::next64(engine) >> 11) + 0.5) * 0x1.0p-53;
+		}
+		
+		// Vitter's Algorithm D: k of [0, n) in increasing order with O(k) expected
+		// draws, falling back to Algorithm A once n <= 13k. Requires n < 2^53.
+		std::vector<uint64_t> vitter_indices(uint64_t n, size_t k) {
+			std::vector<uint64_t> result;
+			result.reserve(k);
+			uint64_t pos = 0;
+			auto select = [&](uint64_t skip) { pos += skip; result.push_back(pos++); };
+			
+			uint64_t N = n, m = k;
+			double nreal = double(m), Nreal = double(N), ninv = 1.0 / nreal;
+			double vprime = std::exp(std::log(open01()) * ninv);
+			uint64_t qu1 = N - m + 1;
+			double qu1real = Nreal - nreal + 1.0;
+			const double alpha_inv = 13.0;
+			double threshold = alpha_inv * nreal;
+			
+			while (m > 1 && threshold < Nreal) {
+				double nmin1inv = 1.0 / (nreal - 1.0);
+				uint64_t S;
+				while (true) {
+					double X;
+					while (true) {
+						X = Nreal * (1.0 - vprime);
+						S = uint64_t(X);
+						if (S < qu1) break;
+						vprime = std::exp(std::log(open01()) * ninv);
+					}
+					double U = open01();
+					double y1 = std::exp(std::log(U * Nreal / qu1real) * nmin1inv);
+					vprime = y1 * (1.0 - X / Nreal) * (qu1real / (qu1real - double(S)));
+					if (vprime <= 1.0) break;
+					
+					double y2 = 1.0, top = Nreal - 1.0, bottom;
+					uint64_t limit;
+					if (m - 1 > S) {
+						bottom = Nreal - nreal;
+						limit = N - S;
+					} else {
+						bottom = Nreal - double(S) - 1.0;
+						limit = qu1;
+					}
+					for (uint64_t t = N - 1; t >= limit; --t) {
+						y2 = (y2 * top) / bottom;
+						top -= 1.0;
+						bottom -= 1.0;
+					}
+					if (Nreal / (Nreal - X) >= y1 * std::exp(std::log(y2) * nmin1inv)) {
+						vprime = std::exp(std::log(open01()) * nmin1inv);
+						break;
+					}
+					vprime = std::exp(std::log(open01()) * ninv);
+				}
+				select(S);
+				N -= S + 1;
+				Nreal -= double(S) + 1.0;
+				--m;
+				nreal -= 1.0;
+				ninv = nmin1inv;
+				qu1 -= S;
+				qu1real -= double(S);
+				threshold -= alpha_inv;
+			}
+			
+			if (m > 1) {
+				double top = Nreal - nreal;
+				while (m >= 2) {
+					double V = open01(), quot = top / Nreal;
+					uint64_t S = 0;
+					while (quot > V) {
+						++S;
+						top -= 1.0;
+						Nreal -= 1.0;
+						quot = (quot * top) / Nreal;
+					}
+					select(S);
+					Nreal -= 1.0;
+					--m;
+				}
+				select(UniformInt<uint64_t>(0, uint64_t(Nreal) - 1)(engine));
+			} else if (m == 1) {
+				select(std::min(uint64_t(Nreal * vprime), N - 1));
+			}
+			return result;
+		}
+		
+		std::vector<uint64_t> stars_and_bars(uint64_t total, size_t k) {
+			std::vector<uint64_t> parts(k);
+			std::vector<uint64_t> bars;
+			if (k > 1) bars = sample_range<uint64_t>(0, total + k - 2, k - 1, true);
+			uint64_t prev = 0;
+			for (size_t i = 0; i + 1 < k; ++i) {
+				parts[i] = bars[i] - prev;
+				prev = bars[i] + 1;
+			}
+			parts[k - 1] = total + k - 1 - prev;
+			return parts;
+		}
+		
+		// k parts in [0, cap] summing to total, with total <= k * cap / 2. Loose bounds
+		// reject stars and bars. Otherwise parts are truncated geometric, tilted to the
+		// target mean, and conditioned on the sum by halving: the first half is drawn
+		// freely and kept with probability P(second half sums to the rest) / max of that
+		// pmf. This is exact, and each level takes O(1) expected tries, so O(k) overall.
+		std::vector<uint64_t> bounded_parts(uint64_t total, size_t k, uint64_t cap) {
+			double mean = double(total) / double(k);
+			if (total == 0) return std::vector<uint64_t>(k, 0);
+			
+			if (mean * (std::log(double(k)) + 1.0) <= double(cap)) {
+				for (int attempt = 0; attempt < 16; ++attempt) {
+					std::vector<uint64_t> parts = stars_and_bars(total, k);
+					if (*std::max_element(parts.begin(), parts.end()) <= cap) return parts;
+				}
+			}
+			
+			// Any tilt gives the exact result; matching the mean keeps the tries O(1).
+			double lambda = 0.0;
+			if (2.0 * mean < double(cap)) {
+				double low = 0.0, high = 64.0;
+				for (int it = 0; it < 100; ++it) {
+					double mid = 0.5 * (low + high);
+					(TruncatedGeometric(mid, cap).mean() > mean ? low : high) = mid;
+				}
+				lambda = 0.5 * (low + high);
+				if (lambda * (double(cap) + 1.0) < 1e-4) lambda = 0.0;
+			}
+			TruncatedGeometric part(lambda, cap);
+			
+			std::vector<uint64_t> parts(k);
+			std::lock_guard<Lock> lock(mtx);
+			size_t begin = 0, m = k;
+			uint64_t left = total;
+			while (m > 64) {
+				size_t h = m / 2, rest = m - h;
+				// The pmf of a sum of log-concave parts is log-concave: climb to its peak.
+				long double top = (long double)rest * cap;
+				uint64_t peak = uint64_t(std::min(top, std::floor((long double)rest * part.mean())));
+				double peak_pmf = part.sum_pmf(rest, peak);
+				for (int dir : { 1, -1 }) {
+					while ((dir > 0 ? (long double)peak < top : peak > 0)) {
+						double next = part.sum_pmf(rest, peak + dir);
+						if (next <= peak_pmf) break;
+						peak += dir;
+						peak_pmf = next;
+					}
+				}
+				peak_pmf *= 1.0 + 1e-9;
+				
+				uint64_t used;
+				do {
+					used = 0;
+					for (size_t i = begin; i < begin + h && used <= left; ++i) used += parts[i] = part(engine);
+				} while (used > left || uniform01(engine) * peak_pmf >= part.sum_pmf(rest, left - used));
+				begin += h;
+				left -= used;
+				m = rest;
+			}
+			
+			// Last few parts: draw all but one and keep the remainder with its weight.
+			while (true) {
+				uint64_t used = 0;
+				for (size_t i = begin; i + 1 < k && used <= left; ++i) used += parts[i] = part(engine);
+				if (used > left || left - used > cap) continue;
+				uint64_t last = left - used;
+				if (lambda > 0.0 && uniform01(engine) >= std::exp(-lambda * double(last))) continue;
+				parts[k - 1] = last;
+				return parts;
+			}
+		}
+		
 	public:
 		explicit Random(unsigned seed = 0)
 		: engine(typename Engine::result_type(seed)) {}
 		
 		Random() : engine(typename Engine::result_type(std::chrono::steady_clock::now().time_since_epoch().count())) {}
 		
+		explicit Random(const Engine& source) : engine(source) {}
+		
+		Random stream(uint64_t k) {
+			std::lock_guard<Lock> lock(mtx);
+			return Random(engine.stream(k));
+		}
+		
+		Random split() {
+			std::lock_guard<Lock> lock(mtx);
+			return Random(engine.split());
+		}
+		
 		int randint(int min, int max) {
-			std::lock_guard<std::mutex> lock(mtx);
-			std::uniform_int_distribution<int> dist(min, max);
-			return dist(engine);
+			if (min > max) throw std::invalid_argument("Invalid range");
+			std::lock_guard<Lock> lock(mtx);
+			return UniformInt<int>(min, max)(engine);
+		}
+		
+		template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+		T randint(T min, T max) {
+			if (min > max) throw std::invalid_argument("Invalid range");
+			std::lock_guard<Lock> lock(mtx);
+			return UniformInt<T>(min, max)(engine);
 		}
 		
 		double random(double min = 0.0, double max = 1.0) {
-			std::lock_guard<std::mutex> lock(mtx);
-			std::uniform_real_distribution<double> dist(min, max);
-			return dist(engine);
+			std::lock_guard<Lock> lock(mtx);
+			return UniformReal(min, max)(engine);
 		}
 		
-		std::string randstr(int length, const std::string& charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789") {
-			std::lock_guard<std::mutex> lock(mtx);
-			
-			if (charset.empty()) return "";
-			
-			std::string result;
-			result.reserve(length);
-			std::uniform_int_distribution<int> dist(0, static_cast<int>(charset.length()) - 1);
-			
-			for (int i = 0; i < length; ++i) {
-				result += charset[dist(engine)];
+		double normal(double mean = 0.0, double stddev = 1.0) {
+			std::lock_guard<Lock> lock(mtx);
+			return Normal(mean, stddev)(engine);
+		}
+		
+		double exponential(double lambda = 1.0) {
+			std::lock_guard<Lock> lock(mtx);
+			return Exponential(lambda)(engine);
+		}
+		
+		long long poisson(double mean) {
+			std::lock_guard<Lock> lock(mtx);
+			return Poisson(mean)(engine);
+		}
+		
+		long long binomial(long long n, double p) {
+			std::lock_guard<Lock> lock(mtx);
+			return Binomial(n, p)(engine);
+		}
+		
+		long long geometric(double p) {
+			std::lock_guard<Lock> lock(mtx);
+			return Geometric(p)(engine);
+		}
+		
+		template<typename T>
+		void randint_fill(std::span<T> out, std::type_identity_t<T> min, std::type_identity_t<T> max) {
+			if (min > max) throw std::invalid_argument("Invalid range");
+			std::lock_guard<Lock> lock(mtx);
+			UniformInt<T> dist(min, max);
+			for (T& x : out) x = dist(engine);
+		}
+		
+		void random_fill(std::span<double> out, double min = 0.0, double max = 1.0) {
+			std::lock_guard<Lock> lock(mtx);
+			UniformReal dist(min, max);
+			for (double& x : out) x = dist(engine);
+		}
+		
+		void normal_fill(std::span<double> out, double mean = 0.0, double stddev = 1.0) {
+			std::lock_guard<Lock> lock(mtx);
+			Normal dist(mean, stddev);
+			for (double& x : out) x = dist(engine);
+		}
+		
+		template<typename T>
+		std::vector<T> randint_n(size_t n, T min, T max) {
+			std::vector<T> result(n);
+			randint_fill(std::span<T>(result), min, max);
+			return result;
+		}
+		
+		std::vector<double> random_n(size_t n, double min = 0.0, double max = 1.0) {
+			std::vector<double> result(n);
+			random_fill(result, min, max);
+			return result;
+		}
+		
+		void randstr_fill(std::span<char> out, std::string_view charset = CHARSET_ALPHANUMERIC) {
+			std::lock_guard<Lock> lock(mtx);
+			CharsetSampler{charset}(engine, out.data(), out.size());
+		}
+		
+		void randPalindromeStr_fill(std::span<char> out) {
+			std::lock_guard<Lock> lock(mtx);
+			size_t n = out.size(), half = n / 2;
+			CharsetSampler{CHARSET_ALPHANUMERIC}(engine, out.data(), half);
+			if (n % 2 == 1) CharsetSampler{CHARSET_ALPHA}(engine, out.data() + half, 1);
+			std::reverse_copy(out.data(), out.data() + half, out.data() + n - half);
+		}
+		
+		void randPeriodStr_fill(std::span<char> out, size_t period) {
+			size_t n = out.size();
+			if (period == 0 || period > n) period = n;
+			{
+				std::lock_guard<Lock> lock(mtx);
+				CharsetSampler{CHARSET_ALPHA}(engine, out.data(), period);
+			}
+			for (size_t filled = period; filled < n; filled *= 2) {
+				std::memcpy(out.data() + filled, out.data(), std::min(filled, n - filled));
 			}
+		}
+		
+		// Streams `length` characters to `out` (an IO or std::ostream) in fixed-size
+		// chunks, so arbitrarily long strings never materialize in memory.
+		template<typename Out>
+		void randstr_to(Out& out, size_t length, std::string_view charset = CHARSET_ALPHANUMERIC) {
+			static constexpr size_t CHUNK = 1 << 16;
+			CharsetSampler sampler(charset);
+			std::vector<char> buffer(std::min(length, CHUNK));
+			while (length > 0) {
+				size_t n = std::min(length, CHUNK);
+				{
+					std::lock_guard<Lock> lock(mtx);
+					sampler(engine, buffer.data(), n);
+				}
+				out << std::string_view(buffer.data(), n);
+				length -= n;
+			}
+		}
+		
+		std::string randstr(int length, const std::string& charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789") {
+			if (charset.empty() || length <= 0) return "";
 			
+			std::string result(length, '\0');
+			randstr_fill(result, charset);
 			return result;
 		}
 		
@@ -76,17 +434,11 @@ namespace STAR_CPP {
 		}
 		
 		std::string randPalindromeStr(int length) {
-			std::string front = randstr(length / 2);
-			std::string back = front;
-			std::reverse(back.begin(), back.end());
+			if (length <= 0) return "";
 			
-			if (length % 2 == 0) {
-				return front + back;
-			}
-			else {
-				std::string middle_char = randstr(1, CHARSET_ALPHA);
-				return front + middle_char + back;
-			}
+			std::string result(length, '\0');
+			randPalindromeStr_fill(result);
+			return result;
 		}
 		
 		std::string randNumericStr(int length) {
@@ -98,41 +450,30 @@ namespace STAR_CPP {
 		}
 		
 		std::string randDistinctStr(int length, int distinct_count) {
-			std::lock_guard<std::mutex> lock(mtx);
 			if (distinct_count <= 0 || distinct_count > (int)CHARSET_ALPHANUMERIC.length()) return "";
-			std::string sub_charset = CHARSET_ALPHANUMERIC.substr(0, distinct_count);
-			std::string result;
-			result.reserve(length);
-			std::uniform_int_distribution<int> dist(0, static_cast<int>(sub_charset.length()) - 1);
-			for (int i = 0; i < length; ++i) {
-				result += sub_charset[dist(engine)];
-			}
-			return result;
+			return randstr(length, CHARSET_ALPHANUMERIC.substr(0, distinct_count));
 		}
 		
 		std::string randPeriodStr(int length, int period) {
-			if (period <= 0) period = length;
-			std::string base = randAlphaStr(period);
-			std::string result;
-			result.reserve(length);
-			for (int i = 0; i < length; ++i) {
-				result += base[i % period];
-			}
+			if (length <= 0) return "";
+			
+			std::string result(length, '\0');
+			randPeriodStr_fill(result, period > 0 ? period : length);
 			return result;
 		}
 		
 		std::vector<int> randperm(int n) {
-			std::lock_guard<std::mutex> lock(mtx);
+			std::lock_guard<Lock> lock(mtx);
 			std::vector<int> result(n);
 			
 			for (int i = 0; i < n; ++i) result[i] = i + 1;
 			
-			std::shuffle(result.begin(), result.end(), engine);
+			shuffle_range(result.begin(), result.end());
 			return result;
 		}
 		
 		std::vector<int> randperm(int min, int max) {
-			std::lock_guard<std::mutex> lock(mtx);
+			std::lock_guard<Lock> lock(mtx);
 			
 			if (min > max) std::swap(min, max);
 			
@@ -141,23 +482,298 @@ namespace STAR_CPP {
 			
 			for (int i = 0; i < n; ++i) result[i] = min + i;
 			
-			std::shuffle(result.begin(), result.end(), engine);
+			shuffle_range(result.begin(), result.end());
+			return result;
+		}
+		
+		// Uniform composition of n into k parts, each at least min_part: stars and bars
+		// over a sorted (k-1)-subset, O(k) draws and memory.
+		template<typename T>
+		std::vector<T> composition(T n, size_t k, std::type_identity_t<T> min_part = 1) {
+			static_assert(std::is_integral_v<T>, "composition requires an integral type");
+			if (k == 0) {
+				if (n == 0) return {};
+				throw std::invalid_argument("Cannot split a nonzero total into zero parts");
+			}
+			if ((long double)n < (long double)min_part * k) throw std::invalid_argument("Total too small for the minimum part");
+			
+			uint64_t slack = uint64_t((long long)n - (long long)min_part * (long long)k);
+			std::vector<uint64_t> parts = stars_and_bars(slack, k);
+			std::vector<T> result(k);
+			for (size_t i = 0; i < k; ++i) result[i] = T(min_part + (long long)parts[i]);
+			return result;
+		}
+		
+		// Uniform array of `len` integers in [lo, hi] summing to `sum`. Loose bounds
+		// reject unbounded compositions; tight ones draw truncated geometric parts
+		// tilted to the target mean (a Boltzmann sampler) and fix the last part.
+		template<typename T>
+		std::vector<T> sum_constrained_array(size_t len, T sum, std::type_identity_t<T> lo, std::type_identity_t<T> hi) {
+			static_assert(std::is_integral_v<T>, "sum_constrained_array requires an integral type");
+			if (lo > hi) std::swap(lo, hi);
+			if (len == 0) {
+				if (sum == 0) return {};
+				throw std::invalid_argument("Cannot reach a nonzero sum with no elements");
+			}
+			
+			long long cap = (long long)hi - (long long)lo;
+			long double slack_ld = (long double)sum - (long double)lo * len;
+			if (slack_ld < 0 || slack_ld > (long double)cap * len) throw std::invalid_argument("Sum out of reach for the given bounds");
+			
+			uint64_t slack = uint64_t((long long)sum - (long long)lo * (long long)len);
+			bool mirrored = false;
+			if (slack > uint64_t(cap) * len / 2) {
+				slack = uint64_t(cap) * len - slack;
+				mirrored = true;
+			}
+			
+			std::vector<uint64_t> parts = bounded_parts(slack, len, uint64_t(cap));
+			std::vector<T> result(len);
+			for (size_t i = 0; i < len; ++i) {
+				long long part = (long long)parts[i];
+				result[i] = T((long long)lo + (mirrored ? cap - part : part));
+			}
+			return result;
+		}
+		
+		// O(1)-memory pseudo-random permutation of [0, n), keyed from this generator.
+		FeistelPermutation lazy_permutation(uint64_t n) {
+			std::lock_guard<Lock> lock(mtx);
+			return FeistelPermutation(n, RandomBits<Engine>::next64(engine));
+		}
+		
+		// Permutation of 1..n with exactly `inversions` inversions. Each Lehmer code
+		// entry takes a binomial share of what is left, clamped so the total stays
+		// reachable, and the code is decoded with a Fenwick tree in O(n log n).
+		std::vector<int> permutation_with_inversions(int n, long long inversions) {
+			if (n < 0) throw std::invalid_argument("Length cannot be negative");
+			long long max_inv = (long long)n * (n - 1) / 2;
+			if (inversions < 0 || inversions > max_inv) throw std::invalid_argument("Inversion count out of range");
+			
+			std::vector<int> code(n);
+			{
+				std::lock_guard<Lock> lock(mtx);
+				long long left = inversions;
+				for (int i = 0; i < n; ++i) {
+					long long cap = n - 1 - i;
+					long long rest = cap * (cap - 1) / 2;
+					long long low = std::max(0LL, left - rest), high = std::min(cap, left);
+					long long c = low;
+					if (low < high) c = std::clamp(Binomial(cap, double(left) / double(cap + rest))(engine), low, high);
+					code[i] = (int)c;
+					left -= c;
+				}
+			}
+			
+			std::vector<int> tree(n + 1);
+			for (int i = 1; i <= n; ++i) tree[i] = i & -i;
+			int top = 1;
+			while (top * 2 <= n) top *= 2;
+			
+			std::vector<int> result(n);
+			for (int i = 0; i < n; ++i) {
+				int pos = 0, k = code[i] + 1;
+				for (int step = top; step > 0; step >>= 1) {
+					if (pos + step <= n && tree[pos + step] < k) {
+						pos += step;
+						k -= tree[pos];
+					}
+				}
+				result[i] = pos + 1;
+				for (int j = pos + 1; j <= n; j += j & -j) --tree[j];
+			}
+			return result;
+		}
+		
+		// Uniform permutation of 1..n with exactly `cycles` cycles (Feller coupling).
+		// Element j opens a new cycle with probability theta / (theta + j - 1) and
+		// otherwise follows one of the j - 1 placed elements, so given which elements open
+		// cycles every permutation is equally likely. That set is conditioned to size
+		// `cycles` by halving, as in bounded_parts. O(n) expected.
+		std::vector<int> permutation_with_cycles(int n, int cycles) {
+			if (cycles < 1 || cycles > n) throw std::invalid_argument("Cycle count out of range");
+			
+			// opens[i] is for element i + 1; element 1 always opens a cycle.
+			std::vector<char> opens(n, 1);
+			uint64_t r = uint64_t(n) - 1, left = uint64_t(cycles) - 1;
+			
+			// Any theta gives the exact result; theta log(1 + r / (theta + 1/2)) tracks the
+			// expected count, and matching it keeps the tries O(1).
+			double theta = 1.0;
+			if (0 < left && left < r) {
+				double low = -40.0, high = 50.0;
+				for (int it = 0; it < 100; ++it) {
+					double mid = 0.5 * (low + high), t = std::exp(mid);
+					(t * std::log1p(double(r) / (t + 0.5)) < double(left) ? low : high) = mid;
+				}
+				theta = std::exp(0.5 * (low + high));
+			}
+			
+			std::lock_guard<Lock> lock(mtx);
+			auto draw = [&](uint64_t i) { return char(uniform01(engine) * (theta + double(i)) < theta); };
+			while (r > 64 && 0 < left && left < r) {
+				uint64_t rest = r - r / 2;
+				CycleStarts low(theta, rest);
+				uint64_t peak = std::min(rest, uint64_t(low.mean()));
+				double peak_pmf = low.pmf(peak);
+				for (int dir : { 1, -1 }) {
+					while (dir > 0 ? peak < rest : peak > 0) {
+						double next = low.pmf(peak + dir);
+						if (next <= peak_pmf) break;
+						peak += dir;
+						peak_pmf = next;
+					}
+				}
+				peak_pmf *= 1.0 + 1e-9;
+				
+				uint64_t used;
+				do {
+					used = 0;
+					for (uint64_t i = rest + 1; i <= r && used <= left; ++i) used += opens[i] = draw(i);
+				} while (used > left || uniform01(engine) * peak_pmf >= low.pmf(left - used));
+				left -= used;
+				r = rest;
+			}
+			if (left == 0 || left == r) {
+				for (uint64_t i = 1; i <= r; ++i) opens[i] = char(left != 0);
+			} else {
+				uint64_t used;
+				do {
+					used = 0;
+					for (uint64_t i = 1; i <= r; ++i) used += opens[i] = draw(i);
+				} while (used != left);
+			}
+			
+			std::vector<int> next(n + 1);
+			for (int j = 1; j <= n; ++j) {
+				if (opens[j - 1]) {
+					next[j] = j;
+				} else {
+					int a = UniformInt<int>(1, j - 1)(engine);
+					next[j] = next[a];
+					next[a] = j;
+				}
+			}
+			return std::vector<int>(next.begin() + 1, next.end());
+		}
+		
+		// Uniform derangement of 1..n (Martinez, Panholzer and Prodinger), about 2n draws.
+		std::vector<int> derangement(int n) {
+			if (n == 1 || n < 0) throw std::invalid_argument("No derangement of this length");
+			
+			// Probability (u-1) D(u-2) / D(u); beyond u = 30 it equals 1/u to double precision.
+			double small[32] = { 1.0, 0.0 };
+			for (int k = 2; k < 32; ++k) small[k] = (k - 1) * (small[k - 1] + small[k - 2]);
+			auto close_prob = [&](int u) { return u < 32 ? (u - 1) * small[u - 2] / small[u] : 1.0 / u; };
+			
+			std::vector<int> a(n + 1);
+			for (int i = 0; i <= n; ++i) a[i] = i;
+			std::vector<char> marked(n + 1, 0);
+			
+			std::lock_guard<Lock> lock(mtx);
+			int i = n, u = n;
+			while (u >= 2) {
+				if (!marked[i]) {
+					int j;
+					do j = UniformInt<int>(1, i - 1)(engine); while (marked[j]);
+					std::swap(a[i], a[j]);
+					if (uniform01(engine) < close_prob(u)) {
+						marked[j] = 1;
+						--u;
+					}
+					--u;
+				}
+				--i;
+			}
+			return std::vector<int>(a.begin() + 1, a.end());
+		}
+		
+		// Uniform single n-cycle on 1..n (Sattolo's algorithm).
+		std::vector<int> cyclic_permutation(int n) {
+			std::lock_guard<Lock> lock(mtx);
+			std::vector<int> result(n);
+			for (int i = 0; i < n; ++i) result[i] = i + 1;
+			for (int i = n - 1; i > 0; --i) std::swap(result[i], result[UniformInt<int>(0, i - 1)(engine)]);
+			return result;
+		}
+		
+		// Permutation of 1..n whose longest increasing subsequence has length exactly `lis`.
+		// Positions get patience-sorting levels (a shuffled composition, relabelled in
+		// order of first appearance); each level is a decreasing run in its own value band.
+		std::vector<int> permutation_with_lis(int n, int lis) {
+			if (lis < 1 || lis > n) throw std::invalid_argument("LIS length out of range");
+			
+			std::vector<int> sizes = composition(n, (size_t)lis);
+			std::vector<int> level(n);
+			for (int b = 0, pos = 0; b < lis; ++b) for (int t = 0; t < sizes[b]; ++t) level[pos++] = b;
+			shuffle(level);
+			
+			std::vector<int> relabel(lis, -1), left(lis, 0);
+			int next = 0;
+			for (int& l : level) {
+				if (relabel[l] < 0) relabel[l] = next++;
+				l = relabel[l];
+				++left[l];
+			}
+			
+			std::vector<int> base(lis, 0);
+			for (int k = 1; k < lis; ++k) base[k] = base[k - 1] + left[k - 1];
+			
+			std::vector<int> result(n);
+			for (int i = 0; i < n; ++i) result[i] = base[level[i]] + left[level[i]]--;
 			return result;
 		}
 		
 		template<typename T>
 		T choice(const std::vector<T>& container) {
-			std::lock_guard<std::mutex> lock(mtx);
+			std::lock_guard<Lock> lock(mtx);
 			
 			if (container.empty()) throw std::invalid_argument("Cannot choice from empty container");
 			
-			std::uniform_int_distribution<size_t> dist(0, container.size() - 1);
+			UniformInt<size_t> dist(0, container.size() - 1);
 			return container[dist(engine)];
 		}
 		
+		// First k positions of a Fisher-Yates shuffle of [0, n). Small k keeps only
+		// the displaced positions in a hash map, so the cost is O(k) time and memory.
+		std::vector<size_t> sample_indices(size_t n, size_t k) {
+			std::lock_guard<Lock> lock(mtx);
+			return partial_shuffle_indices(n, k);
+		}
+		
+		// k distinct integers from [lo, hi] in O(k) memory, in random order or, with
+		// sorted = true, ascending without a final sort for ranges below 2^53.
+		template<typename T>
+		std::vector<T> sample_range(T lo, T hi, size_t k, bool sorted = false) {
+			static_assert(std::is_integral_v<T>, "sample_range requires an integral type");
+			using U = std::make_unsigned_t<T>;
+			std::lock_guard<Lock> lock(mtx);
+			
+			if (lo > hi) std::swap(lo, hi);
+			uint64_t n = uint64_t(U(hi) - U(lo)) + 1;
+			if (n != 0 && k > n) k = size_t(n);
+			if (k == 0) return {};
+			
+			std::vector<uint64_t> index;
+			if (sorted && n != 0 && n < (uint64_t(1) << 53)) {
+				index = vitter_indices(n, k);
+			} else if (!sorted && n != 0) {
+				std::vector<size_t> picked = partial_shuffle_indices(size_t(n), k);
+				index.assign(picked.begin(), picked.end());
+			} else {
+				index = floyd_indices(n, k);
+				if (sorted) std::sort(index.begin(), index.end());
+				else shuffle_range(index.begin(), index.end());
+			}
+			
+			std::vector<T> result(k);
+			for (size_t i = 0; i < k; ++i) result[i] = T(U(lo) + U(index[i]));
+			return result;
+		}
+		
 		template<typename T>
 		std::vector<T> choices(const std::vector<T>& container, int k) {
-			std::lock_guard<std::mutex> lock(mtx);
+			std::lock_guard<Lock> lock(mtx);
 			
 			if (container.empty()) throw std::invalid_argument("Empty container");
 			
@@ -167,58 +783,188 @@ namespace STAR_CPP {
 			
 			if (k <= 0) return {};
 			
-			std::vector<T> result = container;
+			if (k >= n / 64) {
+				std::vector<T> result = container;
+				for (int i = 0; i < k; ++i) {
+					std::swap(result[i], result[UniformInt<int>(i, n - 1)(engine)]);
+				}
+				result.resize(k);
+				return result;
+			}
+			
+			std::vector<T> result;
+			result.reserve(k);
+			for (size_t i : partial_shuffle_indices(container.size(), k)) result.push_back(container[i]);
 			
-			for (int i = 0; i < k; ++i) {
-				std::uniform_int_distribution<int> dist(i, n - 1);
-				int j = dist(engine);
-				std::swap(result[i], result[j]);
+			return result;
+		}
+		
+		// Reservoir sampling (Li's Algorithm L) over a single pass of an input range:
+		// O(k) memory and O(k log(N/k)) draws. Yields every item if the range is shorter than k.
+		template<typename InputIt>
+		std::vector<typename std::iterator_traits<InputIt>::value_type> reservoir_sample(InputIt first, InputIt last, size_t k) {
+			std::lock_guard<Lock> lock(mtx);
+			
+			std::vector<typename std::iterator_traits<InputIt>::value_type> reservoir;
+			if (k == 0) return reservoir;
+			reservoir.reserve(k);
+			
+			for (; first != last && reservoir.size() < k; ++first) reservoir.push_back(*first);
+			if (first == last) return reservoir;
+			
+			UniformInt<size_t> slot(0, k - 1);
+			double w = std::exp(std::log(open01()) / k);
+			
+			while (true) {
+				double skip = std::floor(std::log(open01()) / std::log1p(-w));
+				for (uint64_t s = static_cast<uint64_t>(std::min(skip, 9e18)); s > 0 && first != last; --s) ++first;
+				if (first == last) break;
+				reservoir[slot(engine)] = *first;
+				++first;
+				w *= std::exp(std::log(open01()) / k);
 			}
 			
-			return std::vector<T>(result.begin(), result.begin() + k);
+			return reservoir;
 		}
 		
 		template<typename T>
 		T weightedChoice(const std::vector<T>& items, const std::vector<double>& weights) {
-			std::lock_guard<std::mutex> lock(mtx);
+			std::lock_guard<Lock> lock(mtx);
 			
 			if (items.empty() || weights.empty()) throw std::invalid_argument("Empty inputs");
 			
 			if (items.size() != weights.size()) throw std::invalid_argument("Size mismatch");
 			
-			std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
-			return items[dist(engine)];
+			return items[AliasTable(weights)(engine)];
+		}
+		
+		template<typename T>
+		T weightedChoice(const std::vector<T>& items, const AliasTable& table) {
+			std::lock_guard<Lock> lock(mtx);
+			
+			if (items.empty()) throw std::invalid_argument("Empty inputs");
+			
+			if (items.size() != table.size()) throw std::invalid_argument("Size mismatch");
+			
+			return items[table(engine)];
+		}
+		
+		// Efraimidis-Spirakis without replacement: item i gets key Exp(1) / w_i and the
+		// k smallest keys win, in the order a sequential draw would pick them.
+		// O(n + k log k); zero-weight items are never chosen.
+		std::vector<size_t> weighted_sample_indices(const std::vector<double>& weights, size_t k) {
+			std::lock_guard<Lock> lock(mtx);
+			
+			std::vector<std::pair<double, size_t>> keys;
+			keys.reserve(weights.size());
+			Exponential unit(1.0);
+			for (size_t i = 0; i < weights.size(); ++i) {
+				if (!(weights[i] >= 0.0)) throw std::invalid_argument("Weights must be non-negative");
+				if (weights[i] > 0.0) keys.emplace_back(unit(engine) / weights[i], i);
+			}
+			
+			if (k > keys.size()) k = keys.size();
+			std::nth_element(keys.begin(), keys.begin() + k, keys.end());
+			std::sort(keys.begin(), keys.begin() + k);
+			
+			std::vector<size_t> result(k);
+			for (size_t i = 0; i < k; ++i) result[i] = keys[i].second;
+			return result;
+		}
+		
+		// Streaming weighted sampling without replacement (A-ExpJ): one pass, O(k)
+		// memory, and only O(k log(n/k)) draws, since the exponential jump skips
+		// whole runs of items by accumulated weight.
+		template<typename InputIt, typename WeightFn>
+		std::vector<typename std::iterator_traits<InputIt>::value_type> weighted_reservoir_sample(InputIt first, InputIt last, size_t k, WeightFn weight_of) {
+			using Item = typename std::iterator_traits<InputIt>::value_type;
+			std::lock_guard<Lock> lock(mtx);
+			
+			// Keys are log(u) / w, so larger is better and the heap top is the weakest entry.
+			std::vector<std::pair<double, Item>> heap;
+			if (k == 0) return {};
+			heap.reserve(k);
+			auto weaker = [](const auto& a, const auto& b) { return a.first > b.first; };
+			
+			for (; first != last && heap.size() < k; ++first) {
+				double w = weight_of(*first);
+				if (!(w >= 0.0)) throw std::invalid_argument("Weights must be non-negative");
+				if (w == 0.0) continue;
+				heap.emplace_back(std::log(open01()) / w, *first);
+				std::push_heap(heap.begin(), heap.end(), weaker);
+			}
+			
+			if (heap.size() == k) {
+				double jump = std::log(open01()) / heap.front().first;
+				for (; first != last; ++first) {
+					double w = weight_of(*first);
+					if (!(w >= 0.0)) throw std::invalid_argument("Weights must be non-negative");
+					jump -= w;
+					if (jump > 0.0) continue;
+					
+					double floor_key = heap.front().first;
+					double t = std::exp(floor_key * w);
+					double r = t + (1.0 - t) * open01();
+					std::pop_heap(heap.begin(), heap.end(), weaker);
+					heap.back() = { std::max(std::log(r) / w, floor_key), *first };
+					std::push_heap(heap.begin(), heap.end(), weaker);
+					jump = std::log(open01()) / heap.front().first;
+				}
+			}
+			
+			std::sort_heap(heap.begin(), heap.end(), weaker);
+			std::vector<Item> result;
+			result.reserve(heap.size());
+			for (auto& entry : heap) result.push_back(std::move(entry.second));
+			return result;
 		}
 		
 		template<typename T>
 		void shuffle(std::vector<T>& container) {
-			std::lock_guard<std::mutex> lock(mtx);
-			std::shuffle(container.begin(), container.end(), engine);
+			std::lock_guard<Lock> lock(mtx);
+			shuffle_range(container.begin(), container.end());
+		}
+		
+		// MergeShuffle across `threads` workers (0 = all cores). Deterministic for a
+		// given seed regardless of thread count. The tasks draw from streams of a split
+		// child, so the engine's stream/split must hash their children apart from the
+		// parent (as SplitMix64Rand, XSH_RR_PCG and Philox4x32 do); otherwise the
+		// caller's next draws could replay a task's stream.
+		template<typename T>
+		void parallel_shuffle(std::vector<T>& container, unsigned threads = 0) {
+			Engine base = [&] {
+				std::lock_guard<Lock> lock(mtx);
+				return engine.split();
+			}();
+			merge_shuffle(container.begin(), container.end(), base, threads);
 		}
 		
 		template <typename Distribution>
 		auto operator()(Distribution& dist) -> typename Distribution::result_type {
-			std::lock_guard<std::mutex> lock(mtx);
+			std::lock_guard<Lock> lock(mtx);
 			return dist(engine);
 		}
 	};
 	
-	template <typename Engine>
-	const std::string Random<Engine>::CHARSET_ALPHA =
+	template <typename Engine, typename Lock>
+	const std::string Random<Engine, Lock>::CHARSET_ALPHA =
 	"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
 	
-	template <typename Engine>
-	const std::string Random<Engine>::CHARSET_NUMERIC =
+	template <typename Engine, typename Lock>
+	const std::string Random<Engine, Lock>::CHARSET_NUMERIC =
 	"0123456789";
 	
-	template <typename Engine>
-	const std::string Random<Engine>::CHARSET_HEX =
+	template <typename Engine, typename Lock>
+	const std::string Random<Engine, Lock>::CHARSET_HEX =
 	"0123456789abcdef";
 	
-	template <typename Engine>
-	const std::string Random<Engine>::CHARSET_ALPHANUMERIC =
+	template <typename Engine, typename Lock>
+	const std::string Random<Engine, Lock>::CHARSET_ALPHANUMERIC =
 	"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
 	
+	template <typename Engine>
+	using UnsyncRandom = Random<Engine, NullMutex>;
+	
 }
 
 #endif
@@ -18,66 +18,377 @@ TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
 #ifndef STAR_SEQUENCE_H
 #define STAR_SEQUENCE_H
 
+#include<ranges>
+#include<iterator>
+#include<charconv>
 #include "star_random.h"
 namespace STAR_CPP {
 
-	template <typename Engine>
-	class Sequence {
+	// Lazy arithmetic progression start, start + step, ... up to end inclusive.
+	// Integral progressions are counted up front, so they are sized and never overflow.
+	template <typename Type>
+	class RangeView : public std::ranges::view_interface<RangeView<Type>> {
 	private:
-		Random<Engine> rng;
+		Type first = Type(), last = Type(), step = Type(1);
+		uint64_t count = 0;
 
 	public:
-		explicit Sequence(unsigned seed = 0) : rng(seed) {}
+		class iterator {
+		private:
+			Type value = Type(), step = Type(1), last = Type();
+			uint64_t left = 0;
 
-		template <typename Type>
-		std::vector<Type> range(Type start, Type end, Type step = 1) {
-			if (step == 0) throw std::invalid_argument("Step cannot be zero");
+		public:
+			using value_type = Type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
 
-			std::vector<Type> seq;
+			iterator() = default;
+			iterator(Type value, Type step, Type last, uint64_t left) : value(value), step(step), last(last), left(left) {}
 
-			if constexpr (std::is_integral_v<Type>) {
-				seq.reserve(static_cast<size_t>((end - start) / step) + 10);
+			Type operator*() const { return value; }
+
+			iterator& operator++() {
+				if constexpr (std::is_integral_v<Type>) {
+					if (--left) value += step;
+				} else {
+					value += step;
+				}
+				return *this;
 			}
 
-			if (step > 0) {
-				for (Type i = start; i <= end; i += step) seq.push_back(i);
-			} else {
-				for (Type i = start; i >= end; i += step) seq.push_back(i);
+			iterator operator++(int) {
+				iterator old = *this;
+				++*this;
+				return old;
 			}
 
-			return seq;
+			bool operator==(const iterator& other) const {
+				if constexpr (std::is_integral_v<Type>) return left == other.left;
+				else return value == other.value;
+			}
+
+			bool operator==(std::default_sentinel_t) const {
+				if constexpr (std::is_integral_v<Type>) return left == 0;
+				else return step > 0 ? value > last : value < last;
+			}
+		};
+
+		RangeView() = default;
+
+		RangeView(Type start, Type end, Type step) : first(start), last(end), step(step) {
+			if (step == 0) throw std::invalid_argument("Step cannot be zero");
+			if constexpr (std::is_integral_v<Type>) {
+				using U = std::make_unsigned_t<Type>;
+				if (step > 0 && start <= end) count = uint64_t(U(end) - U(start)) / uint64_t(U(step)) + 1;
+				else if (step < 0 && start >= end) count = uint64_t(U(start) - U(end)) / uint64_t(U(0) - U(step)) + 1;
+			}
 		}
 
-		template <typename Type, typename Dist>
-		std::vector<Type> randomStep(Type start, Type end, Dist dist) {
-			std::vector<Type> seq;
-			Type current = start;
-			const Type direction = (start <= end) ? Type(1) : Type(-1);
+		iterator begin() const { return iterator(first, step, last, count); }
+		std::default_sentinel_t end() const { return {}; }
+
+		size_t size() const requires std::is_integral_v<Type> { return static_cast<size_t>(count); }
+	};
 
-			while ((direction > 0 && current <= end) || (direction < 0 && current >= end)) {
-				seq.push_back(current);
+	// Single-pass walk from start towards end with steps drawn from `dist`; each
+	// increment draws one step from the owning Random, so nothing is buffered.
+	template <typename Type, typename Dist, typename Engine, typename Lock>
+	class RandomStepView : public std::ranges::view_interface<RandomStepView<Type, Dist, Engine, Lock>> {
+	private:
+		Random<Engine, Lock>* rng = nullptr;
+		Dist dist;
+		Type start = Type(), end_value = Type();
+
+	public:
+		class iterator {
+		private:
+			RandomStepView* parent = nullptr;
+			Type current = Type();
+			Type direction = Type(1);
 
-				Type step = rng(dist);
+		public:
+			using value_type = Type;
+			using difference_type = std::ptrdiff_t;
 
+			iterator() = default;
+			explicit iterator(RandomStepView* parent)
+			: parent(parent), current(parent->start), direction((parent->start <= parent->end_value) ? Type(1) : Type(-1)) {}
+
+			Type operator*() const { return current; }
+
+			iterator& operator++() {
+				Type step = (*parent->rng)(parent->dist);
 				if constexpr (std::is_signed_v<Type>) {
 					Type abs_step = (step == 0) ? Type(1) : std::abs(step);
 					current += direction * abs_step;
 				} else {
 					current += step;
 				}
+				return *this;
+			}
+
+			void operator++(int) { ++*this; }
+
+			bool operator==(std::default_sentinel_t) const {
+				return !((direction > 0 && current <= parent->end_value) || (direction < 0 && current >= parent->end_value));
+			}
+		};
+
+		RandomStepView() = default;
+		RandomStepView(Random<Engine, Lock>& rng, Type start, Type end, Dist dist)
+		: rng(&rng), dist(dist), start(start), end_value(end) {}
+
+		iterator begin() { return iterator(this); }
+		std::default_sentinel_t end() const { return {}; }
+	};
+
+	// Single-pass view of n values drawn from `dist`, one draw per increment.
+	template <typename Type, typename Dist, typename Engine, typename Lock>
+	class RandomArrayView : public std::ranges::view_interface<RandomArrayView<Type, Dist, Engine, Lock>> {
+	private:
+		Random<Engine, Lock>* rng = nullptr;
+		Dist dist;
+		size_t count = 0;
+
+	public:
+		class iterator {
+		private:
+			RandomArrayView* parent = nullptr;
+			size_t left = 0;
+			Type current = Type();
+
+		public:
+			using value_type = Type;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+			explicit iterator(RandomArrayView* parent) : parent(parent), left(parent->count) {
+				if (left) current = static_cast<Type>((*parent->rng)(parent->dist));
+			}
+
+			Type operator*() const { return current; }
+
+			iterator& operator++() {
+				if (--left) current = static_cast<Type>((*parent->rng)(parent->dist));
+				return *this;
+			}
+
+			void operator++(int) { ++*this; }
+
+			bool operator==(std::default_sentinel_t) const { return left == 0; }
+		};
+
+		RandomArrayView() = default;
+		RandomArrayView(Random<Engine, Lock>& rng, size_t n, Dist dist) : rng(&rng), dist(dist), count(n) {}
+
+		iterator begin() { return iterator(this); }
+		std::default_sentinel_t end() const { return {}; }
+		size_t size() const { return count; }
+	};
+
+	enum class QueryLength { Uniform, Short, Long, Mixed, Nested, Disjoint };
+
+	// Short lengths are at most sqrt(n), long ones at least 0.9 n; Mixed draws one of
+	// Uniform/Short/Long per query. Nested intervals form a chain, each containing the
+	// next; Disjoint intervals are pairwise non-overlapping and need q <= n.
+	struct QueryOptions {
+		QueryLength length = QueryLength::Uniform;
+		double update_ratio = 0.0;
+		long long value_min = 1, value_max = 1000000000;
+		bool sorted = false;
+	};
+
+	struct Query {
+		static constexpr int UPDATE = 1, QUERY = 2;
+		int type, l, r;
+		long long value;
+	};
+
+	template <typename Engine, typename Lock = std::mutex>
+	class Sequence {
+	private:
+		Random<Engine, Lock> rng;
+
+		static constexpr size_t QUERY_BLOCK = 4096;
+
+		// Uniform value in [0, range) from a pre-drawn word; the rare rejected word is
+		// replaced by a fresh draw, so the result stays exact.
+		uint64_t bounded_word(uint64_t word, uint64_t range) {
+			uint64_t high, low = extend::mul128(word, range, &high);
+			if (low < range && low < (0 - range) % range) return rng.template randint<uint64_t>(0, range - 1);
+			return high;
+		}
+
+		// q sorted uniform integers in [lo, hi] via normalized exponential spacings.
+		std::vector<int> sorted_uniform(size_t q, int lo, int hi) {
+			std::vector<double> gaps(q + 1);
+			rng.random_fill(gaps);
+			double sum = 0;
+			for (double& g : gaps) g = sum += -std::log1p(-g);
+			double span = static_cast<double>(hi) - lo + 1;
+			std::vector<int> values(q);
+			for (size_t i = 0; i < q; i++) values[i] = static_cast<int>(std::min<double>(hi, lo + std::floor(gaps[i] / sum * span)));
+			return values;
+		}
+
+		// Fills `out` with independent queries; one locked bulk draw per array. The
+		// scratch vectors are owned by the caller and reused across blocks.
+		void query_block(int n, const QueryOptions& opt, std::span<Query> out, std::vector<uint64_t>& words, std::vector<long long>& values) {
+			size_t count = out.size(), stride = opt.length == QueryLength::Mixed ? 4 : 3;
+			if (words.size() < stride * count) words.resize(stride * count);
+			if (values.size() < count) values.resize(count);
+			rng.randint_fill(std::span<uint64_t>(words.data(), stride * count), 0, UINT64_MAX);
+			if (opt.update_ratio > 0) rng.randint_fill(std::span<long long>(values.data(), count), opt.value_min, opt.value_max);
+
+			double cut = opt.update_ratio * 0x1p64;
+			uint64_t update_cut = cut >= 0x1p64 ? UINT64_MAX : static_cast<uint64_t>(std::max(cut, 0.0));
+			uint64_t short_max = std::max<uint64_t>(1, static_cast<uint64_t>(std::sqrt(static_cast<double>(n))));
+			uint64_t long_min = std::max<uint64_t>(1, n - n / 10);
+			for (size_t i = 0; i < count; i++) {
+				Query& q = out[i];
+				const uint64_t* w = words.data() + stride * i;
+				uint64_t a = w[0], b = w[1], c = w[2];
+				q.type = c < update_cut ? Query::UPDATE : Query::QUERY;
+				q.value = q.type == Query::UPDATE ? values[i] : 0;
+
+				QueryLength mode = opt.length;
+				if (mode == QueryLength::Mixed) mode = static_cast<QueryLength>(bounded_word(w[3], 3));
+				if (mode == QueryLength::Uniform) {
+					int x = 1 + static_cast<int>(bounded_word(a, n)), y = 1 + static_cast<int>(bounded_word(b, n));
+					q.l = std::min(x, y);
+					q.r = std::max(x, y);
+				} else {
+					uint64_t len = mode == QueryLength::Short ? 1 + bounded_word(b, short_max) : long_min + bounded_word(b, n - long_min + 1);
+					q.l = 1 + static_cast<int>(bounded_word(a, n - len + 1));
+					q.r = q.l + static_cast<int>(len) - 1;
+				}
 			}
+		}
+
+		// Nested or disjoint families, in increasing order of l.
+		std::vector<Query> structured_queries(int n, size_t q, const QueryOptions& opt) {
+			std::vector<Query> result(q);
+			if (opt.length == QueryLength::Nested) {
+				int mid = rng.randint(1, n);
+				std::vector<int> lefts = sorted_uniform(q, 1, mid), rights = sorted_uniform(q, mid, n);
+				for (size_t i = 0; i < q; i++) {
+					result[i].l = lefts[i];
+					result[i].r = rights[q - 1 - i];
+				}
+			} else {
+				if (q > static_cast<size_t>(n)) throw std::invalid_argument("Too many disjoint queries for the array length");
+				// Sorted 2q-subsets of [1, n + q] map bijectively onto q disjoint intervals.
+				std::vector<long long> ends = rng.template sample_range<long long>(1, static_cast<long long>(n) + q, 2 * q, true);
+				for (size_t i = 0; i < q; i++) {
+					result[i].l = static_cast<int>(ends[2 * i] - static_cast<long long>(i));
+					result[i].r = static_cast<int>(ends[2 * i + 1] - static_cast<long long>(i) - 1);
+				}
+			}
+
+			std::vector<double> coins(opt.update_ratio > 0 ? q : 0);
+			rng.random_fill(coins);
+			std::vector<long long> values = opt.update_ratio > 0 ? rng.randint_n(q, opt.value_min, opt.value_max) : std::vector<long long>();
+			for (size_t i = 0; i < q; i++) {
+				bool update = opt.update_ratio > 0 && coins[i] < opt.update_ratio;
+				result[i].type = update ? Query::UPDATE : Query::QUERY;
+				result[i].value = update ? values[i] : 0;
+			}
+			return result;
+		}
+
+		// Stable two-pass LSD radix sort on l (positive ints fit in 31 bits).
+		static void sort_by_left(std::vector<Query>& queries) {
+			std::vector<Query> buffer(queries.size());
+			for (int shift = 0; shift < 32; shift += 16) {
+				std::vector<size_t> start(1 << 16 | 1);
+				for (const Query& q : queries) start[(static_cast<uint32_t>(q.l) >> shift & 0xffff) + 1]++;
+				for (size_t i = 1; i < start.size(); i++) start[i] += start[i - 1];
+				for (const Query& q : queries) buffer[start[static_cast<uint32_t>(q.l) >> shift & 0xffff]++] = q;
+				queries.swap(buffer);
+			}
+		}
+
+		static char* format_query(char* p, const Query& q) {
+			*p++ = static_cast<char>('0' + q.type);
+			*p++ = ' ';
+			p = std::to_chars(p, p + 12, q.l).ptr;
+			*p++ = ' ';
+			p = std::to_chars(p, p + 12, q.r).ptr;
+			if (q.type == Query::UPDATE) {
+				*p++ = ' ';
+				p = std::to_chars(p, p + 21, q.value).ptr;
+			}
+			*p++ = '\n';
+			return p;
+		}
+
+	public:
+		explicit Sequence(unsigned seed = 0) : rng(seed) {}
+
+		template <typename Type>
+		RangeView<Type> range_view(Type start, Type end, Type step = 1) {
+			return RangeView<Type>(start, end, step);
+		}
+
+		template <typename Type>
+		std::vector<Type> range(Type start, Type end, Type step = 1) {
+			RangeView<Type> view(start, end, step);
+			std::vector<Type> seq;
+
+			if constexpr (std::is_integral_v<Type>) seq.reserve(view.size());
+
+			for (Type x : view) seq.push_back(x);
+
+			return seq;
+		}
+
+		template <typename Type, typename Dist>
+		RandomStepView<Type, Dist, Engine, Lock> randomStep_view(Type start, Type end, Dist dist) {
+			return RandomStepView<Type, Dist, Engine, Lock>(rng, start, end, dist);
+		}
+
+		template <typename Type>
+		auto randomStep_view(Type start, Type end, Type min_step, Type max_step) {
+			if constexpr (std::is_integral_v<Type>) return randomStep_view(start, end, UniformInt<Type>(min_step, max_step));
+			else return randomStep_view(start, end, UniformReal(min_step, max_step));
+		}
+
+		template <typename Type, typename Dist>
+		std::vector<Type> randomStep(Type start, Type end, Dist dist) {
+			std::vector<Type> seq;
+
+			for (Type x : randomStep_view(start, end, dist)) seq.push_back(x);
 
 			return seq;
 		}
 
 		template <typename Type>
 		std::vector<Type> randomStep(Type start, Type end, Type min_step, Type max_step) {
+			std::vector<Type> seq;
+
+			for (Type x : randomStep_view(start, end, min_step, max_step)) seq.push_back(x);
+
+			return seq;
+		}
+
+		template <typename Type>
+		auto random_array_view(size_t n, Type min, Type max) {
 			if constexpr (std::is_integral_v<Type>) {
-				std::uniform_int_distribution<Type> dist(min_step, max_step);
-				return randomStep(start, end, dist);
+				return RandomArrayView<Type, UniformInt<Type>, Engine, Lock>(rng, n, UniformInt<Type>(min, max));
 			} else {
-				std::uniform_real_distribution<Type> dist(min_step, max_step);
-				return randomStep(start, end, dist);
+				return RandomArrayView<Type, UniformReal, Engine, Lock>(rng, n, UniformReal((double)min, (double)max));
+			}
+		}
+
+		template <typename Type>
+		std::vector<Type> random_array(size_t n, Type min, Type max) {
+			if constexpr (std::is_integral_v<Type>) {
+				return rng.randint_n(n, min, max);
+			} else {
+				std::vector<double> values = rng.random_n(n, (double)min, (double)max);
+				if constexpr (std::is_same_v<Type, double>) return values;
+				else return std::vector<Type>(values.begin(), values.end());
 			}
 		}
 
@@ -97,38 +408,194 @@ namespace STAR_CPP {
 		}
 
 		template <typename Type>
-		std::vector<Type> sample(Type start, Type end, int k) {
+		std::vector<Type> sample(Type start, Type end, int k, bool sorted = false) {
 			if constexpr(std::is_integral_v<Type>) {
-				if (start > end) std::swap(start, end);
+				if (k <= 0) return {};
 
-				std::vector<Type> full_pop = range(start, end);
-				return sample(full_pop, k);
+				return rng.sample_range(start, end, static_cast<size_t>(k), sorted);
 			} else {
 				throw std::invalid_argument("Sample from range only supports integral types.");
 			}
 		}
 
+		template <typename InputIt>
+		auto reservoir_sample(InputIt first, InputIt last, int k) {
+			return rng.reservoir_sample(first, last, k > 0 ? static_cast<size_t>(k) : 0);
+		}
+
 		template <typename Type>
-		std::vector<Type> weighted_sample(const std::vector<Type>& population, int k, const std::vector<double>& weights) {
+		std::vector<Type> weighted_sample(const std::vector<Type>& population, int k, const std::vector<double>& weights, bool replace = true) {
 			if (population.empty() || weights.empty()) return {};
 
 			if (population.size() != weights.size()) throw std::invalid_argument("Size mismatch");
 
-			std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+			if (replace) return weighted_sample(population, k, AliasTable(weights));
+
 			std::vector<Type> results;
+			if (k <= 0) return results;
 			results.reserve(k);
+			for (size_t i : rng.weighted_sample_indices(weights, static_cast<size_t>(k))) results.push_back(population[i]);
+
+			return results;
+		}
+
+		template <typename InputIt, typename WeightFn>
+		auto weighted_reservoir_sample(InputIt first, InputIt last, int k, WeightFn weight_of) {
+			return rng.weighted_reservoir_sample(first, last, k > 0 ? static_cast<size_t>(k) : 0, weight_of);
+		}
+
+		template <typename Type>
+		std::vector<Type> weighted_sample(const std::vector<Type>& population, int k, const AliasTable& table) {
+			if (population.empty()) return {};
+
+			if (population.size() != table.size()) throw std::invalid_argument("Size mismatch");
+
+			std::vector<Type> results;
+			results.reserve(k > 0 ? k : 0);
 
 			for (int i = 0; i < k; ++i) {
-				results.push_back(population[dist(rng)]);
+				results.push_back(population[rng(table)]);
 			}
 
 			return results;
 		}
 
+		template <typename Type>
+		std::vector<Type> composition(Type n, int k, std::type_identity_t<Type> min_part = 1) {
+			if (k < 0) throw std::invalid_argument("Number of parts cannot be negative");
+			return rng.composition(n, static_cast<size_t>(k), min_part);
+		}
+
+		template <typename Type>
+		std::vector<Type> sum_constrained_array(size_t len, Type sum, std::type_identity_t<Type> lo, std::type_identity_t<Type> hi) {
+			return rng.sum_constrained_array(len, sum, lo, hi);
+		}
+
+		// Uniform balanced parenthesis string with n pairs: n openers and n + 1 closers
+		// are shuffled and rotated by the cycle lemma, then the last closer is dropped.
+		std::string dyck_word(int n) {
+			if (n <= 0) return "";
+			std::vector<char> steps(2 * n + 1, ')');
+			std::fill(steps.begin(), steps.begin() + n, '(');
+			rng.shuffle(steps);
+
+			int sum = 0, low = 0, start = 0;
+			for (int i = 0; i < 2 * n + 1; i++) {
+				sum += steps[i] == '(' ? 1 : -1;
+				if (sum < low) {
+					low = sum;
+					start = i + 1;
+				}
+			}
+
+			std::string word(2 * n, '\0');
+			for (int i = 0; i < 2 * n; i++) word[i] = steps[(start + i) % (2 * n + 1)];
+			return word;
+		}
+
+		// Uniform balanced sequence over the bracket pairs in `pairs` (e.g. "()[]{}"):
+		// a uniform Dyck word with an independent uniform type per matched pair.
+		std::string bracket_sequence(int n, const std::string& pairs = "()") {
+			if (pairs.empty() || pairs.size() % 2 != 0) throw std::invalid_argument("Bracket pairs must come in open/close pairs");
+			if (n <= 0) return "";
+			std::string word = dyck_word(n);
+			int types = static_cast<int>(pairs.size() / 2);
+			if (types == 1) {
+				for (char& c : word) c = c == '(' ? pairs[0] : pairs[1];
+				return word;
+			}
+
+			std::vector<int> type = rng.randint_n(static_cast<size_t>(n), 0, types - 1);
+			std::vector<int> open;
+			int next = 0;
+			for (char& c : word) {
+				if (c == '(') {
+					open.push_back(type[next++]);
+					c = pairs[2 * open.back()];
+				} else {
+					c = pairs[2 * open.back() + 1];
+					open.pop_back();
+				}
+			}
+			return word;
+		}
+
+		// q interval queries over positions [1, n]; updates carry a value in
+		// [value_min, value_max] and appear with probability update_ratio.
+		std::vector<Query> queries(int n, size_t q, const QueryOptions& opt = {}) {
+			if (n <= 0) throw std::invalid_argument("Array length must be positive");
+			if (opt.length == QueryLength::Nested || opt.length == QueryLength::Disjoint) {
+				std::vector<Query> result = structured_queries(n, q, opt);
+				if (!opt.sorted) rng.shuffle(result);
+				return result;
+			}
+
+			std::vector<Query> result(q);
+			std::vector<uint64_t> words;
+			std::vector<long long> values;
+			for (size_t i = 0; i < q; i += QUERY_BLOCK) query_block(n, opt, std::span<Query>(result).subspan(i, std::min(QUERY_BLOCK, q - i)), words, values);
+			if (opt.sorted) sort_by_left(result);
+			return result;
+		}
+
+		// Writes queries as "1 l r v" (update) or "2 l r" lines to `out` (an IO or
+		// std::ostream). Unsorted independent queries are generated block by block.
+		template <typename Out>
+		void queries_to(Out& out, int n, size_t q, const QueryOptions& opt = {}) {
+			if (n <= 0) throw std::invalid_argument("Array length must be positive");
+			static constexpr size_t LINE = 48;
+			std::vector<char> buffer(QUERY_BLOCK * LINE);
+			auto write = [&](std::span<const Query> block) {
+				char* p = buffer.data();
+				for (const Query& x : block) p = format_query(p, x);
+				out << std::string_view(buffer.data(), p - buffer.data());
+			};
+
+			if (opt.sorted || opt.length == QueryLength::Nested || opt.length == QueryLength::Disjoint) {
+				std::vector<Query> all = queries(n, q, opt);
+				for (size_t i = 0; i < q; i += QUERY_BLOCK) write(std::span<const Query>(all).subspan(i, std::min(QUERY_BLOCK, q - i)));
+				return;
+			}
+
+			std::vector<Query> block(QUERY_BLOCK);
+			std::vector<uint64_t> words;
+			std::vector<long long> values;
+			for (size_t i = 0; i < q; i += QUERY_BLOCK) {
+				std::span<Query> part(block.data(), std::min(QUERY_BLOCK, q - i));
+				query_block(n, opt, part, words, values);
+				write(part);
+			}
+		}
+
+		std::vector<int> permutation_with_inversions(int n, long long inversions) {
+			return rng.permutation_with_inversions(n, inversions);
+		}
+
+		std::vector<int> permutation_with_cycles(int n, int cycles) {
+			return rng.permutation_with_cycles(n, cycles);
+		}
+
+		std::vector<int> derangement(int n) {
+			return rng.derangement(n);
+		}
+
+		std::vector<int> cyclic_permutation(int n) {
+			return rng.cyclic_permutation(n);
+		}
+
+		std::vector<int> permutation_with_lis(int n, int lis) {
+			return rng.permutation_with_lis(n, lis);
+		}
+
 		template <typename Type>
 		void shuffle(std::vector<Type>& container) {
 			rng.shuffle(container);
 		}
+
+		template <typename Type>
+		void parallel_shuffle(std::vector<Type>& container, unsigned threads = 0) {
+			rng.parallel_shuffle(container, threads);
+		}
 	};
 
 }
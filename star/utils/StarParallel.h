@@ -0,0 +1,48 @@
+/*
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+Version 2, December 2004
+
+Copyright (C) 2004 Sam Hocevar <sam@hocevar.net>
+
+Everyone is permitted to copy and distribute verbatim or modified
+copies of this license document, and changing it is allowed as long
+as the name is changed.
+
+DO WHAT THE FUCK YOU WANT TO PUBLIC LICENSE
+TERMS AND CONDITIONS FOR COPYING, DISTRIBUTION AND MODIFICATION
+
+0. You just DO WHAT THE FUCK YOU WANT TO.
+
+*/
+
+#ifndef STAR_PARALLEL_H
+#define STAR_PARALLEL_H
+
+#include<cstdint>
+#include<algorithm>
+#include<atomic>
+#include<thread>
+#include<vector>
+
+namespace STAR_CPP {
+
+	// Runs body(t) for every t in [0, tasks) on up to `threads` workers (0 = all
+	// cores), the calling thread included. Tasks are claimed from an atomic counter,
+	// so which worker runs a task is unspecified; results must depend on t alone.
+	template <typename Body>
+	void parallel_for(uint64_t tasks, unsigned threads, Body&& body) {
+		if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+		std::atomic<uint64_t> next(0);
+		auto worker = [&]() {
+			for (uint64_t t; (t = next.fetch_add(1)) < tasks;) body(t);
+		};
+		unsigned count = static_cast<unsigned>(std::min<uint64_t>(threads, tasks));
+		std::vector<std::thread> pool;
+		for (unsigned w = 1; w < count; ++w) pool.emplace_back(worker);
+		worker();
+		for (auto& th : pool) th.join();
+	}
+
+}
+
+#endif